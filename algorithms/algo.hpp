@@ -0,0 +1,37 @@
+// The whole library in one include, for code that links the kernels
+// instead of running the programs. Every header stands alone as well.
+#pragma once
+
+#include "binary_file.hpp"
+#include "bitset.hpp"
+#include "convex_hull.hpp"
+#include "counters.hpp"
+#include "delta_stepping.hpp"
+#include "dijkstra.hpp"
+#include "fibonacci.hpp"
+#include "fractional_knapsack.hpp"
+#include "graph.hpp"
+#include "incremental_hull.hpp"
+#include "insertion_sort.hpp"
+#include "knapsack.hpp"
+#include "kruskal.hpp"
+#include "lcs.hpp"
+#include "linear_search.hpp"
+#include "merge_sort.hpp"
+#include "miller_rabin.hpp"
+#include "mst_parallel.hpp"
+#include "nqueens.hpp"
+#include "partition_kernels.hpp"
+#include "prime_sieve.hpp"
+#include "quick_sort.hpp"
+#include "radix_sort.hpp"
+#include "reduce.hpp"
+#include "search_batch.hpp"
+#include "search_index.hpp"
+#include "sequence_batch.hpp"
+#include "simd.hpp"
+#include "span.hpp"
+#include "sssp_batch.hpp"
+#include "subset_sum.hpp"
+#include "task_pool.hpp"
+#include "thread_pool.hpp"
@@ -0,0 +1,392 @@
+// Binary input files that the algorithms use in place of scanf loops. The
+// original programs read their adjacency matrix, cost matrix, search array
+// or set one number at a time. For any realistic input, that parsing takes
+// longer than the algorithm.
+//
+// The container is a 64-byte BinaryHeader, then its sections, each starting
+// on a 64-byte boundary:
+//  - BinaryKind::Array: count values of elementType.
+//  - BinaryKind::Csr: offsets (count + 1 int64), then adj and weight
+//    (edges int32 each). The layout is the CsrGraph one.
+// Values are in native byte order; the header records it, and open()
+// rejects a file from the other order.
+//
+// BinaryFile maps a file read-only and hands out a Span, or a CsrView, that
+// point into the mapping. Nothing is copied or parsed, and pages are read as
+// the algorithm touches them. open() checks only the header and the section
+// bounds, in O(1); validateGraph() walks the offsets and targets as well.
+//
+// parseInts() is the text side of the converter. It cuts the text at
+// whitespace into chunks, parses the chunks on a ThreadPool with a
+// hand-rolled decimal parser, and concatenates the results.
+//
+// POSIX only (open, mmap).
+#pragma once
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "graph.hpp"
+#include "span.hpp"
+#include "thread_pool.hpp"
+
+namespace algo {
+
+const char BINARY_MAGIC[8] = {'A', 'L', 'G', 'O', 'B', 'I', 'N', '\0'};
+const std::uint32_t BINARY_VERSION = 1;
+const std::uint32_t BINARY_BYTE_ORDER = 0x01020304;
+const std::size_t BINARY_ALIGN = 64;
+// parseInts() chunks per pool worker, for load balance
+const std::size_t PARSE_CHUNKS_PER_WORKER = 4;
+
+enum class BinaryKind : std::uint32_t { Array = 1, Csr = 2 };
+enum class ElementType : std::uint32_t { Int32 = 1, Int64 = 2, UInt64 = 3, Float64 = 4 };
+
+struct BinaryHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    BinaryKind kind;
+    ElementType elementType; // of an Array
+    std::uint64_t count;     // elements of an Array, vertices of a Csr
+    std::uint64_t edges;     // of a Csr
+    std::uint64_t reserved[3];
+};
+
+static_assert(sizeof(BinaryHeader) == BINARY_ALIGN, "the header fills the first section slot");
+
+template <class T>
+constexpr ElementType elementTypeOf()
+{
+    static_assert(std::is_same<T, std::int32_t>::value || std::is_same<T, std::int64_t>::value ||
+                      std::is_same<T, std::uint64_t>::value || std::is_same<T, double>::value,
+                  "no binary element type for T");
+    return std::is_same<T, std::int32_t>::value   ? ElementType::Int32
+           : std::is_same<T, std::int64_t>::value ? ElementType::Int64
+           : std::is_same<T, std::uint64_t>::value ? ElementType::UInt64
+                                                   : ElementType::Float64;
+}
+
+namespace detail {
+
+inline std::uint64_t alignSection(std::uint64_t offset)
+{
+    return (offset + BINARY_ALIGN - 1) / BINARY_ALIGN * BINARY_ALIGN;
+}
+
+inline std::size_t elementSize(ElementType type)
+{
+    return type == ElementType::Int32 ? 4 : 8;
+}
+
+// Byte offsets of the CSR sections and the end of the file
+struct CsrSections {
+    std::uint64_t offsets, adj, weight, end;
+};
+
+inline CsrSections csrSections(std::uint64_t n, std::uint64_t m)
+{
+    CsrSections s;
+    s.offsets = BINARY_ALIGN;
+    s.adj = alignSection(s.offsets + (n + 1) * sizeof(std::int64_t));
+    s.weight = alignSection(s.adj + m * sizeof(int));
+    s.end = s.weight + m * sizeof(int);
+    return s;
+}
+
+inline BinaryHeader makeHeader(BinaryKind kind, ElementType type, std::uint64_t count, std::uint64_t edges)
+{
+    BinaryHeader h;
+    std::memset(&h, 0, sizeof h);
+    std::memcpy(h.magic, BINARY_MAGIC, sizeof h.magic);
+    h.version = BINARY_VERSION;
+    h.byteOrder = BINARY_BYTE_ORDER;
+    h.kind = kind;
+    h.elementType = type;
+    h.count = count;
+    h.edges = edges;
+    return h;
+}
+
+// Writes bytes, then zeros up to the next section boundary
+inline bool writeSection(FILE* f, const void* data, std::size_t bytes)
+{
+    static const char zeros[BINARY_ALIGN] = {};
+    std::size_t pad = static_cast<std::size_t>(alignSection(bytes) - bytes);
+    return (bytes == 0 || fwrite(data, 1, bytes, f) == bytes) && (pad == 0 || fwrite(zeros, 1, pad, f) == pad);
+}
+
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+// The ints of text[begin, end), which starts and ends on a token boundary.
+// Returns the offset of the first bad token, or end.
+inline std::size_t parseIntsChunk(const char* text, std::size_t begin, std::size_t end, std::vector<int>& out)
+{
+    std::size_t i = begin;
+    for (;;) {
+        while (i < end && isSpace(text[i]))
+            i++;
+        if (i == end)
+            return end;
+        const std::size_t token = i;
+        const bool negative = text[i] == '-';
+        if (negative || text[i] == '+')
+            i++;
+        std::uint64_t v = 0;
+        const std::size_t digits = i;
+        while (i < end && static_cast<unsigned>(text[i] - '0') < 10) {
+            v = v * 10 + static_cast<unsigned>(text[i] - '0');
+            if (v > std::uint64_t(1) << 31)
+                return token;
+            i++;
+        }
+        if (i == digits || (i < end && !isSpace(text[i])) || (!negative && v > 0x7fffffff))
+            return token;
+        out.push_back(negative ? static_cast<int>(-static_cast<std::int64_t>(v)) : static_cast<int>(v));
+    }
+}
+
+} // namespace detail
+
+// Read-only mapping of a whole file, unmapped on destruction
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+    ~MappedFile() { close(); }
+
+    // False with errno set if the file cannot be opened or mapped. An empty
+    // file maps to size() == 0. sequential asks the kernel to read ahead.
+    bool open(const char* path, bool sequential = false)
+    {
+        close();
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        bool ok = fstat(fd, &st) == 0;
+        if (ok && st.st_size > 0) {
+            void* p = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            ok = p != MAP_FAILED;
+            if (ok) {
+                data_ = static_cast<const char*>(p);
+                size_ = static_cast<std::size_t>(st.st_size);
+                if (sequential)
+                    madvise(p, size_, MADV_SEQUENTIAL);
+            }
+        }
+        ::close(fd);
+        return ok;
+    }
+
+    void close()
+    {
+        if (data_)
+            munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// A mapped container file
+class BinaryFile {
+public:
+    // Maps path and checks the header and section bounds. On failure
+    // returns false with the reason in *error.
+    bool open(const char* path, std::string* error = nullptr)
+    {
+        auto fail = [&](const char* why) {
+            if (error)
+                *error = why;
+            file_.close();
+            return false;
+        };
+        if (!file_.open(path))
+            return fail(std::strerror(errno));
+        if (file_.size() < sizeof(BinaryHeader))
+            return fail("shorter than a header");
+        std::memcpy(&header_, file_.data(), sizeof header_);
+        if (std::memcmp(header_.magic, BINARY_MAGIC, sizeof header_.magic) != 0)
+            return fail("not a binary container");
+        if (header_.byteOrder != BINARY_BYTE_ORDER)
+            return fail("written with the other byte order");
+        if (header_.version != BINARY_VERSION)
+            return fail("unknown version");
+        if (header_.kind == BinaryKind::Array) {
+            if (header_.elementType < ElementType::Int32 || header_.elementType > ElementType::Float64)
+                return fail("unknown element type");
+            if (header_.count > (file_.size() - BINARY_ALIGN) / detail::elementSize(header_.elementType))
+                return fail("truncated array");
+        } else if (header_.kind == BinaryKind::Csr) {
+            // Each edge takes 8 bytes, so no valid count overflows below
+            if (header_.count > 0x7fffffff || header_.edges > file_.size())
+                return fail("graph too large");
+            if (detail::csrSections(header_.count, header_.edges).end > file_.size())
+                return fail("truncated graph");
+            const std::int64_t* offsets = graph().offsets.data();
+            if (offsets[0] != 0 || offsets[header_.count] != static_cast<std::int64_t>(header_.edges))
+                return fail("offsets do not span the edges");
+        } else {
+            return fail("unknown kind");
+        }
+        return true;
+    }
+
+    const BinaryHeader& header() const { return header_; }
+
+    // The values of an Array of T; empty for any other file
+    template <class T>
+    Span<const T> array() const
+    {
+        if (!file_.data() || header_.kind != BinaryKind::Array || header_.elementType != elementTypeOf<T>())
+            return {};
+        return {reinterpret_cast<const T*>(file_.data() + BINARY_ALIGN), static_cast<std::size_t>(header_.count)};
+    }
+
+    // The graph of a Csr file, pointing into the mapping; empty otherwise
+    CsrView graph() const
+    {
+        if (!file_.data() || header_.kind != BinaryKind::Csr)
+            return {};
+        const detail::CsrSections s = detail::csrSections(header_.count, header_.edges);
+        const std::size_t m = static_cast<std::size_t>(header_.edges);
+        return {static_cast<int>(header_.count),
+                {reinterpret_cast<const std::int64_t*>(file_.data() + s.offsets), static_cast<std::size_t>(header_.count) + 1},
+                {reinterpret_cast<const int*>(file_.data() + s.adj), m},
+                {reinterpret_cast<const int*>(file_.data() + s.weight), m}};
+    }
+
+    // Offsets non-decreasing and every target a vertex: O(n + m), reads
+    // the whole graph
+    bool validateGraph() const
+    {
+        CsrView g = graph();
+        if (header_.kind != BinaryKind::Csr)
+            return false;
+        for (int u = 0; u < g.n; u++)
+            if (g.offsets[u] > g.offsets[u + 1])
+                return false;
+        for (int v : g.adj)
+            if (v < 0 || v >= g.n)
+                return false;
+        return true;
+    }
+
+private:
+    MappedFile file_;
+    BinaryHeader header_{};
+};
+
+template <class T>
+bool writeBinaryArray(const char* path, Span<const T> values)
+{
+    FILE* f = fopen(path, "wb");
+    if (!f)
+        return false;
+    const BinaryHeader h = detail::makeHeader(BinaryKind::Array, elementTypeOf<T>(), values.size(), 0);
+    bool ok = detail::writeSection(f, &h, sizeof h) && detail::writeSection(f, values.data(), values.size() * sizeof(T));
+    return fclose(f) == 0 && ok;
+}
+
+inline bool writeBinaryGraph(const char* path, CsrView g)
+{
+    FILE* f = fopen(path, "wb");
+    if (!f)
+        return false;
+    const std::size_t m = static_cast<std::size_t>(g.edgeCount());
+    const BinaryHeader h = detail::makeHeader(BinaryKind::Csr, ElementType::Int32, g.n, m);
+    bool ok = detail::writeSection(f, &h, sizeof h) &&
+              detail::writeSection(f, g.offsets.data(), (static_cast<std::size_t>(g.n) + 1) * sizeof(std::int64_t)) &&
+              detail::writeSection(f, g.adj.data(), m * sizeof(int)) && detail::writeSection(f, g.weight.data(), m * sizeof(int));
+    return fclose(f) == 0 && ok;
+}
+
+// Appends the whitespace-separated decimal ints of text[0, size) to out,
+// parsing chunks in parallel on the pool when it is set. Returns false at a
+// token that is not an int, with its byte offset in *errorAt; out is then
+// unchanged.
+inline bool parseInts(const char* text, std::size_t size, std::vector<int>& out, ThreadPool* pool = nullptr,
+                      std::size_t* errorAt = nullptr)
+{
+    if (!pool || pool->size() == 1) {
+        const std::size_t start = out.size();
+        const std::size_t bad = detail::parseIntsChunk(text, 0, size, out);
+        if (bad == size)
+            return true;
+        out.resize(start);
+        if (errorAt)
+            *errorAt = bad;
+        return false;
+    }
+    const std::size_t chunks = PARSE_CHUNKS_PER_WORKER * pool->size();
+    // Chunk k is [cut[k], cut[k + 1]); each cut is moved forward onto
+    // whitespace so no token is split
+    std::vector<std::size_t> cut(chunks + 1, size);
+    cut[0] = 0;
+    for (std::size_t k = 1; k < chunks; k++) {
+        std::size_t at = std::max(cut[k - 1], size / chunks * k);
+        while (at < size && !detail::isSpace(text[at]))
+            at++;
+        cut[k] = at;
+    }
+    std::vector<std::vector<int>> parts(chunks);
+    std::vector<std::size_t> bad(chunks);
+    auto work = [&](unsigned, std::size_t b, std::size_t e) {
+        for (std::size_t k = b; k < e; k++) {
+            // About one int per four bytes of text
+            parts[k].reserve((cut[k + 1] - cut[k]) / 4);
+            bad[k] = detail::parseIntsChunk(text, cut[k], cut[k + 1], parts[k]);
+        }
+    };
+    pool->parallelFor(chunks, 1, work);
+
+    std::vector<std::size_t> at(chunks + 1, out.size());
+    for (std::size_t k = 0; k < chunks; k++) {
+        if (bad[k] != cut[k + 1]) {
+            if (errorAt)
+                *errorAt = bad[k];
+            return false;
+        }
+        at[k + 1] = at[k] + parts[k].size();
+    }
+    out.resize(at[chunks]);
+    auto copy = [&](unsigned, std::size_t b, std::size_t e) {
+        for (std::size_t k = b; k < e; k++)
+            std::copy(parts[k].begin(), parts[k].end(), out.begin() + static_cast<std::ptrdiff_t>(at[k]));
+    };
+    pool->parallelFor(chunks, 1, copy);
+    return true;
+}
+
+} // namespace algo
@@ -0,0 +1,75 @@
+// Runtime-sized bitset with the word-parallel shift-or that subset-sum style
+// DPs are built on: reach |= reach << x updates 64 sums per instruction.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace algo {
+
+class DynamicBitset {
+public:
+    explicit DynamicBitset(std::size_t bits = 0) : bits_(bits), words_((bits + 63) / 64, 0) {}
+
+    std::size_t size() const { return bits_; }
+
+    bool test(std::size_t i) const { return (words_[i >> 6] >> (i & 63)) & 1; }
+    void set(std::size_t i) { words_[i >> 6] |= std::uint64_t(1) << (i & 63); }
+
+    // this |= this << shift, in place; bits shifted past size() are dropped.
+    // Words are updated from the top down, so every source word is read
+    // before it is overwritten.
+    void orShiftedLeft(std::size_t shift)
+    {
+        const std::size_t count = words_.size();
+        const std::size_t q = shift >> 6;
+        const unsigned r = static_cast<unsigned>(shift & 63);
+        if (q >= count)
+            return;
+        if (r == 0) {
+            for (std::size_t i = count; i-- > q;)
+                words_[i] |= words_[i - q];
+        } else {
+            for (std::size_t i = count; i-- > q + 1;)
+                words_[i] |= (words_[i - q] << r) | (words_[i - q - 1] >> (64 - r));
+            words_[q] |= words_[0] << r;
+        }
+        trim();
+    }
+
+    // Highest set bit at or below limit, or -1 if there is none.
+    long long highestSetAtOrBelow(std::size_t limit) const
+    {
+        if (bits_ == 0)
+            return -1;
+        if (limit >= bits_)
+            limit = bits_ - 1;
+        std::size_t i = limit >> 6;
+        std::uint64_t w = words_[i];
+        unsigned top = static_cast<unsigned>(limit & 63);
+        if (top < 63)
+            w &= (std::uint64_t(1) << (top + 1)) - 1;
+        for (;;) {
+            if (w)
+                return static_cast<long long>(i * 64 + 63 - __builtin_clzll(w));
+            if (i == 0)
+                return -1;
+            w = words_[--i];
+        }
+    }
+
+    const std::vector<std::uint64_t>& words() const { return words_; }
+
+private:
+    void trim()
+    {
+        if (bits_ & 63)
+            words_.back() &= (std::uint64_t(1) << (bits_ & 63)) - 1;
+    }
+
+    std::size_t bits_;
+    std::vector<std::uint64_t> words_;
+};
+
+} // namespace algo
@@ -0,0 +1,264 @@
+// Convex hull by Andrew's monotone chain. The original divide() merges
+// hulls in merger(), which mallocs n1 + n2 Pairs per merge and never frees
+// the halves. Its brute-force base case tests every pair of points against
+// every point, then sorts by angle around a global mid after scaling the
+// coordinates by k, which can overflow int.
+//
+// Here the points are radix sorted by (x, y) in place, packed into one
+// 64-bit key each, with the hull buffer as the radix buffer. The lower
+// chain is then built left to right and the upper chain right to left, each
+// point popping the ones it makes non-convex. Each chain only takes the
+// points on its side of the line from the first point to the last. Turns
+// are exact for every int coordinate: differences in 64 bits, products in
+// 128. Nothing is allocated; the hull goes to the caller's buffer, which
+// must hold n + 1 points.
+//
+// The hull is in counter-clockwise order, like the original's output,
+// starting from the smallest (x, y). keepCollinear keeps the points lying on
+// hull edges, as the original's base case does.
+//
+// The TaskPool overload sorts with the parallel radix sort and is the
+// original's divide() again: each chain is built from the chains of its two
+// x-halves, forked as tasks below HULL_TASK_CUTOFF points, and merged in
+// place. Both overloads join the two chains with detail::joinChains().
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "radix_sort.hpp"
+#include "task_pool.hpp"
+
+namespace algo {
+
+// Below this the TaskPool overload runs sequentially
+const std::size_t HULL_PARALLEL_MIN = std::size_t(1) << 16;
+
+// The TaskPool overload builds the chains of at most this many points in one
+// task
+const std::size_t HULL_TASK_CUTOFF = std::size_t(1) << 14;
+
+struct Point {
+    int x, y;
+};
+
+inline bool operator==(const Point& a, const Point& b) { return a.x == b.x && a.y == b.y; }
+inline bool operator!=(const Point& a, const Point& b) { return !(a == b); }
+
+// (x, y) lexicographic
+inline bool pointLess(const Point& a, const Point& b) { return a.x < b.x || (a.x == b.x && a.y < b.y); }
+
+// > 0 if o -> a -> b turns counter-clockwise, < 0 clockwise, 0 collinear
+inline int turn(const Point& o, const Point& a, const Point& b)
+{
+    __int128 lhs = static_cast<__int128>(static_cast<long long>(a.x) - o.x) * (static_cast<long long>(b.y) - o.y);
+    __int128 rhs = static_cast<__int128>(static_cast<long long>(a.y) - o.y) * (static_cast<long long>(b.x) - o.x);
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+namespace detail {
+
+// (x, y) as one unsigned key ordered like pointLess
+inline std::uint64_t pointKey(const Point& p)
+{
+    return std::uint64_t(static_cast<std::uint32_t>(p.x) ^ 0x80000000u) << 32 |
+           (static_cast<std::uint32_t>(p.y) ^ 0x80000000u);
+}
+
+inline Point keyPoint(std::uint64_t key)
+{
+    return {static_cast<int>(static_cast<std::uint32_t>(key >> 32) ^ 0x80000000u),
+            static_cast<int>(static_cast<std::uint32_t>(key) ^ 0x80000000u)};
+}
+
+// Sort points[0..n) by pointLess: each point is overwritten by its key, the
+// keys are radix sorted with scratch (n points) as the buffer, and decoded
+// back. The radix passes run on pool when it is set.
+inline void sortPoints(Point* points, std::size_t n, Point* scratch, TaskPool* pool)
+{
+    static_assert(sizeof(Point) == sizeof(std::uint64_t), "a point must fit its key");
+    auto encode = [points](unsigned, std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; i++) {
+            std::uint64_t key = pointKey(points[i]);
+            std::memcpy(&points[i], &key, sizeof key);
+        }
+    };
+    auto decode = [points](unsigned, std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; i++) {
+            std::uint64_t key;
+            std::memcpy(&key, &points[i], sizeof key);
+            points[i] = keyPoint(key);
+        }
+    };
+    std::uint64_t* keys = reinterpret_cast<std::uint64_t*>(points);
+    std::uint64_t* buffer = reinterpret_cast<std::uint64_t*>(scratch);
+    if (pool) {
+        pool->parallelFor(n, 0, encode);
+        parallelLsdRadixSort<std::uint64_t, char, false>(keys, buffer, nullptr, nullptr, n, *pool);
+        pool->parallelFor(n, 0, decode);
+    } else {
+        encode(0, 0, n);
+        radixSortWithBuffer(keys, n, buffer);
+        decode(0, 0, n);
+    }
+}
+
+// Push p on the chain out[0..k), popping the points it makes non-convex;
+// out[0..floor] stay.
+inline void pushHull(Point* out, std::size_t& k, std::size_t floor, const Point& p, bool keepCollinear)
+{
+    while (k >= floor + 2) {
+        int t = turn(out[k - 2], out[k - 1], p);
+        if (t > 0 || (keepCollinear && t == 0))
+            break;
+        k--;
+    }
+    out[k++] = p;
+}
+
+// Push the distinct points of the sorted points[lo..hi) lying strictly on
+// one side of first -> last: below it left to right for the lower chain,
+// above it right to left for the upper one. With onLine, push the points
+// strictly between first and last on the line instead, in the same order.
+//
+// The points on the line are hull vertices only if every point is, and on
+// the boundary only if the line is a hull edge, with one chain empty. Chains
+// never share points, so the hull never holds more than n + 1.
+inline void sideChain(const Point* points, std::size_t lo, std::size_t hi, bool lower, bool onLine,
+                      const Point& first, const Point& last, Point* out, std::size_t& k, std::size_t floor,
+                      bool keepCollinear)
+{
+    const int side = onLine ? 0 : lower ? -1 : 1;
+    for (std::size_t j = lo; j < hi; j++) {
+        std::size_t i = lower ? j : hi - 1 - (j - lo);
+        const Point& p = points[i];
+        if ((i == 0 || p != points[i - 1]) && turn(first, last, p) == side && (!onLine || (p != first && p != last)))
+            pushHull(out, k, floor, p, keepCollinear);
+    }
+}
+
+// sideChain() of points[lo..hi) into out[0..k), without a floor, from the
+// chains of the two halves as tasks. The half the chain visits first is
+// built in out and the other right after it; running the chain over the
+// second onto the first merges them in place, as no push writes past the
+// point being read.
+inline void sideChainTasks(const Point* points, std::size_t lo, std::size_t hi, bool lower, const Point& first,
+                           const Point& last, Point* out, std::size_t& k, TaskPool& pool, bool keepCollinear)
+{
+    k = 0;
+    if (hi - lo <= HULL_TASK_CUTOFF) {
+        sideChain(points, lo, hi, lower, false, first, last, out, k, 0, keepCollinear);
+        return;
+    }
+    const std::size_t mid = lo + (hi - lo) / 2;
+    const std::size_t firstLo = lower ? lo : mid, firstHi = lower ? mid : hi;
+    const std::size_t secondLo = lower ? mid : lo, secondHi = lower ? hi : mid;
+    const std::size_t offset = firstHi - firstLo;
+    std::size_t k1, k2;
+    pool.invoke([&] { sideChainTasks(points, firstLo, firstHi, lower, first, last, out, k1, pool, keepCollinear); },
+                [&] {
+                    sideChainTasks(points, secondLo, secondHi, lower, first, last, out + offset, k2, pool,
+                                   keepCollinear);
+                });
+    k = k1;
+    for (std::size_t j = 0; j < k2; j++) {
+        const Point p = out[offset + j];
+        pushHull(out, k, 0, p, keepCollinear);
+    }
+}
+
+// The hull of the sorted points[0..n) into hull[] from its two chains;
+// returns its size. pushLower(out, k, floor) pushes the lower chain left to
+// right and pushUpper(out, k, floor) the upper chain right to left, each
+// through pushHull() above floor.
+template <class PushLower, class PushUpper>
+std::size_t joinChains(const Point* points, std::size_t n, Point* hull, PushLower pushLower, PushUpper pushUpper,
+                       bool keepCollinear)
+{
+    const Point first = points[0], last = points[n - 1];
+    hull[0] = first;
+    if (first == last)
+        return 1;
+
+    std::size_t k = 1;
+    pushLower(hull, k, 0);
+    const bool lowerEmpty = k == 1;
+    if (keepCollinear && lowerEmpty)
+        sideChain(points, 0, n, true, true, first, last, hull, k, 0, keepCollinear);
+    pushHull(hull, k, 0, last, keepCollinear);
+    const std::size_t floor = k - 1;
+    pushUpper(hull, k, floor);
+    if (k == floor + 1) {
+        // All collinear: the lower chain is the segment
+        if (lowerEmpty)
+            return k;
+        if (keepCollinear)
+            sideChain(points, 0, n, false, true, first, last, hull, k, floor, keepCollinear);
+    }
+    pushHull(hull, k, floor, first, keepCollinear);
+    // The upper chain ends on the first point again
+    return k - 1;
+}
+
+} // namespace detail
+
+// Hull of points[0..n) into hull[], counter-clockwise from the smallest
+// (x, y); returns its size. points is sorted in place; hull holds n + 1.
+inline std::size_t convexHull(Point* points, std::size_t n, Point* hull, bool keepCollinear = false)
+{
+    if (n == 0)
+        return 0;
+    detail::sortPoints(points, n, hull, nullptr);
+    const Point first = points[0], last = points[n - 1];
+    auto chain = [&](bool lower) {
+        return [&, lower](Point* out, std::size_t& k, std::size_t floor) {
+            detail::sideChain(points, 0, n, lower, false, first, last, out, k, floor, keepCollinear);
+        };
+    };
+    return detail::joinChains(points, n, hull, chain(true), chain(false), keepCollinear);
+}
+
+// convexHull() on a TaskPool; it may be called from inside another task.
+// Allocates two scratch arrays of n points.
+inline std::size_t convexHull(Point* points, std::size_t n, Point* hull, TaskPool& pool, bool keepCollinear = false)
+{
+    if (pool.size() == 1 || n < HULL_PARALLEL_MIN)
+        return convexHull(points, n, hull, keepCollinear);
+    detail::sortPoints(points, n, hull, &pool);
+    const Point first = points[0], last = points[n - 1];
+    std::vector<Point> lower(n), upper(n);
+    std::size_t lowerSize = 0, upperSize = 0;
+    if (first != last)
+        pool.invoke(
+            [&] {
+                detail::sideChainTasks(points, 0, n, true, first, last, lower.data(), lowerSize, pool, keepCollinear);
+            },
+            [&] {
+                detail::sideChainTasks(points, 0, n, false, first, last, upper.data(), upperSize, pool,
+                                       keepCollinear);
+            });
+
+    // The chains are convex already, so running them once more only joins them
+    auto chain = [&](const std::vector<Point>& side, const std::size_t& size) {
+        return [&](Point* out, std::size_t& k, std::size_t floor) {
+            for (std::size_t j = 0; j < size; j++)
+                detail::pushHull(out, k, floor, side[j], keepCollinear);
+        };
+    };
+    return detail::joinChains(points, n, hull, chain(lower, lowerSize), chain(upper, upperSize), keepCollinear);
+}
+
+// convexHull() on a copy, sequential when pool is null
+inline std::vector<Point> convexHull(std::vector<Point> points, TaskPool* pool = nullptr, bool keepCollinear = false)
+{
+    std::vector<Point> hull(points.size() + 1);
+    std::size_t size = pool ? convexHull(points.data(), points.size(), hull.data(), *pool, keepCollinear)
+                            : convexHull(points.data(), points.size(), hull.data(), keepCollinear);
+    hull.resize(size);
+    return hull;
+}
+
+} // namespace algo
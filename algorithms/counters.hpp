@@ -0,0 +1,275 @@
+// Hot-path instrumentation. A slower quickSort() or dijkstra() shows up as
+// wall time only; these counters say whether the cause is comparisons,
+// moves, heap traffic or the memory system. There are two layers:
+//  - Algorithm counters: comparisons, element moves, recursion depth, edge
+//    relaxations, heap operations and DP cells, bumped by the ALGO_COUNT()
+//    and ALGO_DEPTH_SCOPE() hooks in the kernels. They exist only in builds
+//    with -DALGO_COUNTERS; otherwise both hooks expand to nothing and do
+//    not evaluate their arguments, so the kernels compile to the same code
+//    as without them. Each thread counts into its own slot, and counters()
+//    sums the slots, so pool workers never write a shared line. The hooks
+//    add a whole partition, merge or DP row at once where the count is
+//    known; comparisons go through countComparisons(), which wraps the
+//    caller's comparator once.
+//  - PerfCounters: cycles, instructions, last-level cache misses and branch
+//    misses from perf_event_open(), Linux only.
+// bench_all --counters reports both for every run.
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace algo {
+
+#ifdef ALGO_COUNTERS
+const bool COUNTERS_ENABLED = true;
+#else
+const bool COUNTERS_ENABLED = false;
+#endif
+
+struct Counters {
+    std::uint64_t comparisons = 0;
+    std::uint64_t moves = 0;       // element moves and swaps
+    std::uint64_t maxDepth = 0;    // deepest recursion level reached
+    std::uint64_t relaxations = 0; // edges scanned by the shortest-path kernels
+    std::uint64_t heapOps = 0;     // priority queue pushes and pops
+    std::uint64_t cells = 0;       // DP table cells computed
+
+    Counters& operator+=(const Counters& o)
+    {
+        comparisons += o.comparisons;
+        moves += o.moves;
+        maxDepth = std::max(maxDepth, o.maxDepth);
+        relaxations += o.relaxations;
+        heapOps += o.heapOps;
+        cells += o.cells;
+        return *this;
+    }
+};
+
+namespace detail {
+
+struct CounterSlot;
+
+struct CounterRegistry {
+    std::mutex lock;
+    std::vector<CounterSlot*> live;
+    Counters retired; // counts of threads that have exited
+};
+
+// Never destroyed, so pool threads that outlive static destruction can
+// still retire their slots
+inline CounterRegistry& counterRegistry()
+{
+    static CounterRegistry* registry = new CounterRegistry;
+    return *registry;
+}
+
+struct CounterSlot {
+    Counters counts;
+    std::uint64_t depth = 0;
+
+    CounterSlot()
+    {
+        CounterRegistry& r = counterRegistry();
+        std::lock_guard<std::mutex> guard(r.lock);
+        r.live.push_back(this);
+    }
+
+    ~CounterSlot()
+    {
+        CounterRegistry& r = counterRegistry();
+        std::lock_guard<std::mutex> guard(r.lock);
+        r.retired += counts;
+        r.live.erase(std::find(r.live.begin(), r.live.end(), this));
+    }
+
+    CounterSlot(const CounterSlot&) = delete;
+    CounterSlot& operator=(const CounterSlot&) = delete;
+};
+
+inline CounterSlot& counterSlot()
+{
+    thread_local CounterSlot slot;
+    return slot;
+}
+
+// One recursion level for as long as it lives
+class DepthScope {
+public:
+    DepthScope() : slot_(counterSlot())
+    {
+        if (++slot_.depth > slot_.counts.maxDepth)
+            slot_.counts.maxDepth = slot_.depth;
+    }
+    ~DepthScope() { slot_.depth--; }
+
+    DepthScope(const DepthScope&) = delete;
+    DepthScope& operator=(const DepthScope&) = delete;
+
+private:
+    CounterSlot& slot_;
+};
+
+template <class Compare>
+struct CountingCompare {
+    Compare comp;
+
+    template <class A, class B>
+    bool operator()(const A& a, const B& b) const
+    {
+        counterSlot().counts.comparisons++;
+        return comp(a, b);
+    }
+};
+
+} // namespace detail
+
+#ifdef ALGO_COUNTERS
+#define ALGO_COUNT(field, amount) (::algo::detail::counterSlot().counts.field += (amount))
+#define ALGO_DEPTH_SCOPE() ::algo::detail::DepthScope algoDepthScope_
+#else
+#define ALGO_COUNT(field, amount) ((void)0)
+#define ALGO_DEPTH_SCOPE() ((void)0)
+#endif
+
+// comp, counting its calls in instrumented builds. A comparator that is
+// already counting is passed through, so nested kernels count once.
+template <class Compare>
+auto countComparisons(Compare comp)
+{
+#ifdef ALGO_COUNTERS
+    return detail::CountingCompare<Compare>{comp};
+#else
+    return comp;
+#endif
+}
+
+template <class Compare>
+detail::CountingCompare<Compare> countComparisons(detail::CountingCompare<Compare> comp)
+{
+    return comp;
+}
+
+// Totals over every thread. Call it while no kernel is running; the counts
+// of pool workers are visible once the parallelFor that ran them returns.
+inline Counters counters()
+{
+    detail::CounterRegistry& r = detail::counterRegistry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    Counters total = r.retired;
+    for (const detail::CounterSlot* slot : r.live)
+        total += slot->counts;
+    return total;
+}
+
+inline void resetCounters()
+{
+    detail::CounterRegistry& r = detail::counterRegistry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    r.retired = Counters();
+    for (detail::CounterSlot* slot : r.live)
+        slot->counts = Counters();
+}
+
+enum class PerfEvent { Cycles, Instructions, CacheMisses, BranchMisses };
+
+const int PERF_EVENTS = 4;
+
+inline const char* perfEventName(PerfEvent e)
+{
+    switch (e) {
+    case PerfEvent::Cycles: return "cycles";
+    case PerfEvent::Instructions: return "instructions";
+    case PerfEvent::CacheMisses: return "llc_misses";
+    case PerfEvent::BranchMisses: return "branch_misses";
+    }
+    return "?";
+}
+
+// Hardware event counts of this process in user space. Each event is its
+// own counter rather than one group, so that the kernel can schedule
+// whichever the PMU has room for. When there are not enough counters, the
+// kernel multiplexes them, and read() scales each value by its enabled over
+// running time. Counters are inherited by threads created after open(), so
+// open them before the ThreadPool that should be counted.
+class PerfCounters {
+public:
+    PerfCounters() = default;
+    ~PerfCounters() { close(); }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // True when at least one event could be opened. A missing PMU, a
+    // container, or perf_event_paranoid can refuse some or all of them.
+    bool open()
+    {
+        close();
+#ifdef __linux__
+        static const std::uint64_t config[PERF_EVENTS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                          PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (int e = 0; e < PERF_EVENTS; e++) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof attr);
+            attr.size = sizeof attr;
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = config[e];
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fd_[e] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+        return isOpen();
+    }
+
+    void close()
+    {
+#ifdef __linux__
+        for (int& fd : fd_)
+            if (fd >= 0)
+                ::close(fd);
+#endif
+        std::fill(fd_, fd_ + PERF_EVENTS, -1);
+    }
+
+    bool isOpen() const
+    {
+        return std::any_of(fd_, fd_ + PERF_EVENTS, [](int fd) { return fd >= 0; });
+    }
+    bool available(PerfEvent e) const { return fd_[static_cast<int>(e)] >= 0; }
+
+    // Running totals since open(), indexed by PerfEvent; 0 for an event that
+    // is not available. Take the difference of two reads around a region.
+    void read(std::uint64_t* values) const
+    {
+        for (int e = 0; e < PERF_EVENTS; e++) {
+            values[e] = 0;
+#ifdef __linux__
+            std::uint64_t data[3]; // value, time enabled, time running
+            if (fd_[e] < 0 || ::read(fd_[e], data, sizeof data) != static_cast<ssize_t>(sizeof data))
+                continue;
+            values[e] = data[2] == 0 || data[2] == data[1]
+                            ? data[0]
+                            : static_cast<std::uint64_t>(static_cast<double>(data[0]) * data[1] / data[2]);
+#endif
+        }
+    }
+
+private:
+    int fd_[PERF_EVENTS] = {-1, -1, -1, -1};
+};
+
+} // namespace algo
@@ -0,0 +1,211 @@
+// Parallel delta-stepping single-source shortest paths (Meyer & Sanders).
+// Tentative distances are grouped into buckets of width delta; each bucket's
+// frontier is relaxed in parallel on a ThreadPool, light edges (w <= delta)
+// repeatedly until the bucket empties, then heavy edges once.
+//
+// The buckets are a ring of at most DELTA_RING_MAX slots starting at the
+// current bucket. Vertices whose bucket lies past the ring wait in an
+// overflow heap and are moved in once the ring reaches them, so a small
+// delta against large weights costs neither memory nor empty-slot scans;
+// the next bucket comes from a heap of the non-empty ones.
+//
+// distance[] matches dijkstra() for any non-negative weights. pred[] is
+// rebuilt after the distances settle using dijkstra()'s tie-break (the
+// predecessor settled first, by (distance, vertex)), so it matches as well
+// when all weights are positive, as in the matrix program where 0 means
+// "no edge".
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "counters.hpp"
+#include "dijkstra.hpp"
+#include "graph.hpp"
+#include "thread_pool.hpp"
+
+namespace algo {
+
+// Bucket slots in the ring, whatever maxWeight / delta is
+const std::size_t DELTA_RING_MAX = 1 << 12;
+
+// Heuristic bucket width, maxWeight / average degree, which keeps the number
+// of light-edge re-relaxations low on random sparse graphs.
+inline long long defaultDelta(CsrView g)
+{
+    long long maxWeight = 1;
+    for (int w : g.weight)
+        maxWeight = std::max<long long>(maxWeight, w);
+    long long degree = g.n ? std::max<long long>(1, g.edgeCount() / g.n) : 1;
+    return std::max<long long>(1, maxWeight / degree);
+}
+
+// delta <= 0 uses defaultDelta(g).
+inline void deltaStepping(CsrView g, int startnode, long long delta, ThreadPool& pool,
+                          std::vector<long long>& distance, std::vector<int>& pred)
+{
+    const int n = g.n;
+    if (delta <= 0)
+        delta = defaultDelta(g);
+
+    long long maxWeight = 0;
+    for (int w : g.weight)
+        maxWeight = std::max<long long>(maxWeight, w);
+
+    // Every live tentative distance lies within maxWeight of the current
+    // bucket, so with maxWeight / delta + 2 slots nothing overflows
+    const std::size_t ring =
+        static_cast<std::size_t>(std::min<long long>(maxWeight / delta + 2, static_cast<long long>(DELTA_RING_MAX)));
+    std::vector<std::vector<int>> buckets(ring);
+    // Bucket numbers of the non-empty slots, and (bucket, vertex) past the
+    // ring; both may hold stale entries that are skipped when popped
+    std::priority_queue<long long, std::vector<long long>, std::greater<long long>> pending;
+    std::priority_queue<std::pair<long long, int>, std::vector<std::pair<long long, int>>,
+                        std::greater<std::pair<long long, int>>>
+        overflow;
+
+    std::vector<std::atomic<long long>> dist(n);
+    for (int i = 0; i < n; i++)
+        dist[i].store(INFINITY_DIST, std::memory_order_relaxed);
+    dist[startnode].store(0, std::memory_order_relaxed);
+
+    long long current = 0, phase = 0;
+    auto place = [&](int v, long long index) {
+        if (index >= current + static_cast<long long>(ring)) {
+            overflow.push({index, v});
+            return;
+        }
+        std::vector<int>& slot = buckets[index % ring];
+        if (slot.empty())
+            pending.push(index);
+        slot.push_back(v);
+    };
+    place(startnode, 0);
+
+    std::vector<std::vector<int>> improved(pool.size());
+    std::vector<int> frontier, settled, taken;
+    std::vector<long long> inFrontier(n, -1), inSettled(n, -1);
+
+    auto relax = [&](const std::vector<int>& nodes, bool light) {
+        pool.parallelFor(nodes.size(), 0, [&](unsigned worker, std::size_t b, std::size_t e) {
+            std::vector<int>& out = improved[worker];
+            for (std::size_t k = b; k < e; k++) {
+                int u = nodes[k];
+                long long du = dist[u].load(std::memory_order_relaxed);
+                ALGO_COUNT(relaxations, g.offsets[u + 1] - g.offsets[u]);
+                for (std::int64_t x = g.offsets[u]; x < g.offsets[u + 1]; x++) {
+                    int w = g.weight[x];
+                    if ((w <= delta) != light)
+                        continue;
+                    int v = g.adj[x];
+                    long long nd = du + w;
+                    long long cur = dist[v].load(std::memory_order_relaxed);
+                    while (nd < cur) {
+                        if (dist[v].compare_exchange_weak(cur, nd, std::memory_order_relaxed)) {
+                            out.push_back(v);
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+
+        // Sequential merge keeps the buckets free of locks
+        for (std::vector<int>& out : improved) {
+            for (int v : out)
+                place(v, dist[v].load(std::memory_order_relaxed) / delta);
+            out.clear();
+        }
+    };
+
+    for (;;) {
+        // Slots in the ring hold only their own bucket, so an entry below
+        // current or on an empty slot is stale
+        while (!pending.empty() && (pending.top() < current || buckets[pending.top() % ring].empty()))
+            pending.pop();
+        while (!overflow.empty() &&
+               dist[overflow.top().second].load(std::memory_order_relaxed) / delta != overflow.top().first)
+            overflow.pop();
+        if (!overflow.empty() && (pending.empty() || overflow.top().first <= pending.top())) {
+            // The ring has nothing before the first overflow bucket: move it
+            // there and take in what now fits, which may join a bucket the
+            // ring already holds
+            current = overflow.top().first;
+            while (!overflow.empty() && overflow.top().first < current + static_cast<long long>(ring)) {
+                std::pair<long long, int> top = overflow.top();
+                overflow.pop();
+                if (dist[top.second].load(std::memory_order_relaxed) / delta == top.first)
+                    place(top.second, top.first);
+            }
+            continue;
+        }
+        if (pending.empty())
+            break;
+        current = pending.top();
+        pending.pop();
+
+        std::vector<int>& bucket = buckets[current % ring];
+        settled.clear();
+        while (!bucket.empty()) {
+            taken.swap(bucket);
+            bucket.clear();
+
+            // Drop stale entries and duplicates
+            frontier.clear();
+            for (int v : taken) {
+                if (dist[v].load(std::memory_order_relaxed) / delta != current || inFrontier[v] == phase)
+                    continue;
+                inFrontier[v] = phase;
+                frontier.push_back(v);
+                if (inSettled[v] != current) {
+                    inSettled[v] = current;
+                    settled.push_back(v);
+                }
+            }
+            phase++;
+            relax(frontier, true);
+        }
+        relax(settled, false);
+        current++;
+    }
+
+    distance.resize(n);
+    for (int i = 0; i < n; i++)
+        distance[i] = dist[i].load(std::memory_order_relaxed);
+
+    // pred[v] is the tight in-edge whose source comes first in (distance, vertex)
+    std::vector<std::atomic<int>> best(n);
+    for (int i = 0; i < n; i++)
+        best[i].store(-1, std::memory_order_relaxed);
+    pool.parallelFor(n, 0, [&](unsigned, std::size_t b, std::size_t e) {
+        for (std::size_t uu = b; uu < e; uu++) {
+            int u = static_cast<int>(uu);
+            long long du = distance[u];
+            if (du == INFINITY_DIST)
+                continue;
+            for (std::int64_t x = g.offsets[u]; x < g.offsets[u + 1]; x++) {
+                int v = g.adj[x];
+                if (v == startnode || v == u || du + g.weight[x] != distance[v])
+                    continue;
+                int cur = best[v].load(std::memory_order_relaxed);
+                while (cur == -1 || du < distance[cur] || (du == distance[cur] && u < cur)) {
+                    if (best[v].compare_exchange_weak(cur, u, std::memory_order_relaxed))
+                        break;
+                }
+            }
+        }
+    });
+
+    pred.resize(n);
+    for (int i = 0; i < n; i++) {
+        int p = best[i].load(std::memory_order_relaxed);
+        pred[i] = p >= 0 ? p : startnode;
+    }
+}
+
+} // namespace algo
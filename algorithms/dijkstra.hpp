@@ -0,0 +1,161 @@
+// Heap-based Dijkstra over a CSR graph, O((V + E) log V).
+// Produces the same distance[]/pred[] as the adjacency-matrix dijkstra():
+// unreachable nodes keep distance INFINITY and pred == startnode.
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+#include "counters.hpp"
+#include "graph.hpp"
+
+namespace algo {
+
+const long long INFINITY_DIST = LLONG_MAX;
+
+// Binary min-heap over vertex ids with decrease-key. Keys are compared as
+// (distance, vertex) so that ties pop the lowest vertex first, which is the
+// order the linear nextnode scan in dijkstra() picks them in.
+// clear() is O(1): per-vertex slots carry a generation stamp and are only
+// trusted when the stamp matches, so a reused heap never rewrites its arrays.
+class IndexedMinHeap {
+public:
+    explicit IndexedMinHeap(int n = 0) { reset(n); }
+
+    void reset(int n)
+    {
+        heap_.clear();
+        heap_.reserve(n);
+        pos_.assign(n, -1);
+        key_.assign(n, INFINITY_DIST);
+        stamp_.assign(n, 0);
+        generation_ = 1;
+    }
+
+    void clear()
+    {
+        heap_.clear();
+        if (++generation_ == 0) {
+            std::fill(stamp_.begin(), stamp_.end(), 0u);
+            generation_ = 1;
+        }
+    }
+
+    int capacity() const { return static_cast<int>(pos_.size()); }
+    bool empty() const { return heap_.empty(); }
+    bool contains(int v) const { return stamp_[v] == generation_ && pos_[v] >= 0; }
+
+    // Insert v, or lower its key if it is already queued.
+    void push(int v, long long key)
+    {
+        ALGO_COUNT(heapOps, 1);
+        if (stamp_[v] != generation_) {
+            stamp_[v] = generation_;
+            pos_[v] = -1;
+        }
+        if (pos_[v] < 0) {
+            pos_[v] = static_cast<int>(heap_.size());
+            heap_.push_back(v);
+        } else if (key >= key_[v]) {
+            return;
+        }
+        key_[v] = key;
+        siftUp(pos_[v]);
+    }
+
+    int pop()
+    {
+        ALGO_COUNT(heapOps, 1);
+        int top = heap_[0];
+        int last = heap_.back();
+        heap_.pop_back();
+        pos_[top] = -1;
+        if (!heap_.empty()) {
+            heap_[0] = last;
+            pos_[last] = 0;
+            siftDown(0);
+        }
+        return top;
+    }
+
+private:
+    bool less(int a, int b) const
+    {
+        return key_[a] < key_[b] || (key_[a] == key_[b] && a < b);
+    }
+
+    void siftUp(int i)
+    {
+        int v = heap_[i];
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (!less(v, heap_[parent]))
+                break;
+            heap_[i] = heap_[parent];
+            pos_[heap_[i]] = i;
+            i = parent;
+        }
+        heap_[i] = v;
+        pos_[v] = i;
+    }
+
+    void siftDown(int i)
+    {
+        int n = static_cast<int>(heap_.size());
+        int v = heap_[i];
+        for (;;) {
+            int child = 2 * i + 1;
+            if (child >= n)
+                break;
+            if (child + 1 < n && less(heap_[child + 1], heap_[child]))
+                child++;
+            if (!less(heap_[child], v))
+                break;
+            heap_[i] = heap_[child];
+            pos_[heap_[i]] = i;
+            i = child;
+        }
+        heap_[i] = v;
+        pos_[v] = i;
+    }
+
+    std::vector<int> heap_;
+    std::vector<int> pos_;        // index of each vertex in heap_, -1 if absent
+    std::vector<long long> key_;
+    std::vector<unsigned> stamp_; // slot is valid when equal to generation_
+    unsigned generation_ = 1;
+};
+
+// Single-source shortest paths from startnode. distance and pred are resized
+// to g.n. Edge weights must be non-negative.
+inline void dijkstra(CsrView g, int startnode,
+                     std::vector<long long>& distance, std::vector<int>& pred)
+{
+    distance.assign(g.n, INFINITY_DIST);
+    pred.assign(g.n, startnode);
+
+    IndexedMinHeap heap(g.n);
+    distance[startnode] = 0;
+    heap.push(startnode, 0);
+
+    while (!heap.empty()) {
+        int nextnode = heap.pop();
+        long long mindistance = distance[nextnode];
+        ALGO_COUNT(relaxations, g.offsets[nextnode + 1] - g.offsets[nextnode]);
+
+        // check if a better path exists through nextnode
+        for (std::int64_t k = g.offsets[nextnode]; k < g.offsets[nextnode + 1]; k++) {
+            int i = g.adj[k];
+            long long d = mindistance + g.weight[k];
+            if (d < distance[i]) {
+                distance[i] = d;
+                pred[i] = nextnode;
+                heap.push(i, d);
+            }
+        }
+    }
+}
+
+} // namespace algo
@@ -0,0 +1,438 @@
+// Fibonacci numbers. The original adds int terms in a loop, which overflows
+// after the 46th term, and calls printf once per term.
+//
+// Single terms come from fast doubling:
+//     F(2k) = F(k) (2 F(k+1) - F(k)),   F(2k+1) = F(k)^2 + F(k+1)^2
+// It is the 2x2 matrix power [[1 1] [1 0]]^n with the redundant entries
+// dropped, so it needs O(log n) steps.
+//  - fibonacci() works in 64-bit words. It is exact up to
+//    FIBONACCI_MAX_EXACT.
+//  - fibonacciMod() works modulo any m, in Montgomery form when m is odd.
+//  - fibonacciBig() works in BigUnsigned with Karatsuba multiplication. The
+//    last doubling step computes only the half it needs, and a
+//    ThreadPool can run the three products of each step side by side.
+//
+// BigUnsigned keeps base 10^9 limbs, so decimal output is a direct copy of
+// the limbs with no base conversion.
+//
+// writeFibonacciSeries() writes the first n terms, exact at any length,
+// into a buffer of fibonacciSeriesBound(n) bytes. Each term is one limb
+// addition away from the last two. The caller writes the buffer with one
+// fwrite.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "miller_rabin.hpp"
+#include "thread_pool.hpp"
+
+namespace algo {
+
+const std::uint64_t FIBONACCI_MAX_EXACT = 93; // F(93) < 2^64 < F(94)
+const std::uint32_t BIG_BASE = 1000000000;
+const std::size_t BIG_BASE_DIGITS = 9;
+// Products of this many limbs or fewer are multiplied schoolbook
+const std::size_t KARATSUBA_CUTOFF = 24;
+// Doubling steps on numbers this long run their products on the pool
+const std::size_t FIBONACCI_PARALLEL_MIN_LIMBS = 2048;
+
+namespace detail {
+
+// (F(n), F(n + 1)) by fast doubling in the ring of mul, add and sub, whose
+// unit is one
+template <class Word, class Mul, class Add, class Sub>
+std::pair<Word, Word> fibonacciPair(std::uint64_t n, Word one, Mul mul, Add add, Sub sub)
+{
+    Word a = 0, b = one;
+    for (int shift = n ? 63 - __builtin_clzll(n) : -1; shift >= 0; shift--) {
+        Word c = mul(a, sub(add(b, b), a));
+        Word d = add(mul(a, a), mul(b, b));
+        if ((n >> shift) & 1) {
+            a = d;
+            b = add(c, d);
+        } else {
+            a = c;
+            b = d;
+        }
+    }
+    return {a, b};
+}
+
+struct DigitPairs {
+    char text[200];
+
+    constexpr DigitPairs() : text()
+    {
+        for (int i = 0; i < 100; i++) {
+            text[2 * i] = static_cast<char>('0' + i / 10);
+            text[2 * i + 1] = static_cast<char>('0' + i % 10);
+        }
+    }
+};
+
+inline constexpr DigitPairs DIGIT_PAIRS{};
+
+// The nine digits of v < 10^9, with leading zeros
+inline char* writeLimb(char* out, std::uint32_t v)
+{
+    out[0] = static_cast<char>('0' + v / 100000000);
+    v %= 100000000;
+    for (int i = 7; i > 0; i -= 2) {
+        const char* pair = DIGIT_PAIRS.text + 2 * (v % 100);
+        out[i] = pair[0];
+        out[i + 1] = pair[1];
+        v /= 100;
+    }
+    return out + BIG_BASE_DIGITS;
+}
+
+// The digits of v < 10^9 without leading zeros
+inline char* writeTopLimb(char* out, std::uint32_t v)
+{
+    char digits[BIG_BASE_DIGITS];
+    writeLimb(digits, v);
+    std::size_t skip = 0;
+    while (skip + 1 < BIG_BASE_DIGITS && digits[skip] == '0')
+        skip++;
+    return std::copy(digits + skip, digits + BIG_BASE_DIGITS, out);
+}
+
+inline std::size_t limbDigits(std::uint32_t v)
+{
+    std::size_t d = 1;
+    for (std::uint32_t p = 10; d < BIG_BASE_DIGITS && v >= p; p *= 10)
+        d++;
+    return d;
+}
+
+// r[0, nr) += b[0, nb), nb <= nr; the sum fits in nr limbs
+inline void addLimbs(std::uint32_t* r, std::size_t nr, const std::uint32_t* b, std::size_t nb)
+{
+    std::uint32_t carry = 0;
+    std::size_t i = 0;
+    for (; i < nb; i++) {
+        std::uint32_t s = r[i] + b[i] + carry;
+        carry = s >= BIG_BASE;
+        r[i] = carry ? s - BIG_BASE : s;
+    }
+    for (; carry && i < nr; i++) {
+        carry = ++r[i] == BIG_BASE;
+        if (carry)
+            r[i] = 0;
+    }
+}
+
+// r[0, nr) -= b[0, nb), nb <= nr; r is not less than b
+inline void subtractLimbs(std::uint32_t* r, std::size_t nr, const std::uint32_t* b, std::size_t nb)
+{
+    std::uint32_t borrow = 0;
+    std::size_t i = 0;
+    for (; i < nb; i++) {
+        std::uint32_t x = b[i] + borrow;
+        borrow = r[i] < x;
+        r[i] = borrow ? r[i] + BIG_BASE - x : r[i] - x;
+    }
+    for (; borrow && i < nr; i++) {
+        borrow = r[i] == 0;
+        r[i] = borrow ? BIG_BASE - 1 : r[i] - 1;
+    }
+}
+
+// r[0, na + nb) = a * b
+inline void schoolbookMultiply(const std::uint32_t* a, std::size_t na, const std::uint32_t* b, std::size_t nb,
+                               std::uint32_t* r)
+{
+    std::fill(r, r + na + nb, 0);
+    for (std::size_t i = 0; i < na; i++) {
+        const std::uint64_t x = a[i];
+        std::uint64_t carry = 0;
+        for (std::size_t j = 0; j < nb; j++) {
+            std::uint64_t t = r[i + j] + x * b[j] + carry;
+            r[i + j] = static_cast<std::uint32_t>(t % BIG_BASE);
+            carry = t / BIG_BASE;
+        }
+        r[i + nb] = static_cast<std::uint32_t>(carry);
+    }
+}
+
+// Scratch limbs karatsubaMultiply() needs for n-limb operands
+inline std::size_t karatsubaScratch(std::size_t n)
+{
+    std::size_t total = 0;
+    while (n > KARATSUBA_CUTOFF) {
+        std::size_t h = n - n / 2 + 1;
+        total += 4 * h;
+        n = h;
+    }
+    return total;
+}
+
+// r[0, 2n) = a * b for n-limb a and b. The middle product is taken from
+// the half sums, (a0 + a1)(b0 + b1) - a0 b0 - a1 b1.
+inline void karatsubaMultiply(const std::uint32_t* a, const std::uint32_t* b, std::size_t n, std::uint32_t* r,
+                              std::uint32_t* scratch)
+{
+    if (n <= KARATSUBA_CUTOFF) {
+        schoolbookMultiply(a, n, b, n, r);
+        return;
+    }
+    const std::size_t m = n / 2, h = n - m + 1;
+    karatsubaMultiply(a, b, m, r, scratch);
+    karatsubaMultiply(a + m, b + m, n - m, r + 2 * m, scratch);
+
+    std::uint32_t* sa = scratch;
+    std::uint32_t* sb = sa + h;
+    std::uint32_t* mid = sb + h;
+    std::copy(a + m, a + n, sa);
+    std::copy(b + m, b + n, sb);
+    sa[h - 1] = sb[h - 1] = 0;
+    addLimbs(sa, h, a, m);
+    addLimbs(sb, h, b, m);
+    karatsubaMultiply(sa, sb, h, mid, mid + 2 * h);
+    subtractLimbs(mid, 2 * h, r, 2 * m);
+    subtractLimbs(mid, 2 * h, r + 2 * m, 2 * (n - m));
+    addLimbs(r + m, 2 * n - m, mid, 2 * h);
+}
+
+// r[0, na + nb) = a * b. The longer operand is cut into pieces as long as
+// the shorter one, so every Karatsuba product is balanced.
+inline void multiplyLimbs(const std::uint32_t* a, std::size_t na, const std::uint32_t* b, std::size_t nb,
+                          std::uint32_t* r)
+{
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (nb <= KARATSUBA_CUTOFF) {
+        schoolbookMultiply(a, na, b, nb, r);
+        return;
+    }
+    std::vector<std::uint32_t> work(3 * nb + karatsubaScratch(nb));
+    std::uint32_t* piece = work.data();
+    std::uint32_t* product = piece + nb;
+    std::fill(r, r + na + nb, 0);
+    for (std::size_t at = 0; at < na; at += nb) {
+        const std::size_t len = std::min(nb, na - at);
+        std::fill(std::copy(a + at, a + at + len, piece), piece + nb, 0);
+        karatsubaMultiply(piece, b, nb, product, product + 2 * nb);
+        addLimbs(r + at, na + nb - at, product, len + nb);
+    }
+}
+
+} // namespace detail
+
+// Unsigned integer of any size, in little-endian base 10^9 limbs
+class BigUnsigned {
+public:
+    BigUnsigned() = default;
+
+    explicit BigUnsigned(std::uint64_t v)
+    {
+        for (; v > 0; v /= BIG_BASE)
+            limbs_.push_back(static_cast<std::uint32_t>(v % BIG_BASE));
+    }
+
+    bool isZero() const { return limbs_.empty(); }
+    const std::vector<std::uint32_t>& limbs() const { return limbs_; }
+
+    // Number of decimal digits, 1 for zero
+    std::size_t digits() const
+    {
+        if (limbs_.empty())
+            return 1;
+        return (limbs_.size() - 1) * BIG_BASE_DIGITS + detail::limbDigits(limbs_.back());
+    }
+
+    // Writes digits() characters; returns the end
+    char* writeDecimal(char* out) const
+    {
+        if (limbs_.empty()) {
+            *out = '0';
+            return out + 1;
+        }
+        out = detail::writeTopLimb(out, limbs_.back());
+        for (std::size_t i = limbs_.size() - 1; i-- > 0;)
+            out = detail::writeLimb(out, limbs_[i]);
+        return out;
+    }
+
+    std::string toString() const
+    {
+        std::string s(digits(), '0');
+        writeDecimal(&s[0]);
+        return s;
+    }
+
+    // *this % m, m > 0
+    std::uint64_t mod(std::uint64_t m) const
+    {
+        std::uint64_t r = 0;
+        for (std::size_t i = limbs_.size(); i-- > 0;)
+            r = static_cast<std::uint64_t>((static_cast<unsigned __int128>(r) * BIG_BASE + limbs_[i]) % m);
+        return r;
+    }
+
+    friend bool operator==(const BigUnsigned& a, const BigUnsigned& b) { return a.limbs_ == b.limbs_; }
+    friend bool operator!=(const BigUnsigned& a, const BigUnsigned& b) { return a.limbs_ != b.limbs_; }
+
+    friend BigUnsigned operator+(const BigUnsigned& a, const BigUnsigned& b)
+    {
+        const BigUnsigned& longer = a.limbs_.size() >= b.limbs_.size() ? a : b;
+        const BigUnsigned& shorter = &longer == &a ? b : a;
+        BigUnsigned r;
+        r.limbs_.reserve(longer.limbs_.size() + 1);
+        r.limbs_ = longer.limbs_;
+        r.limbs_.push_back(0);
+        detail::addLimbs(r.limbs_.data(), r.limbs_.size(), shorter.limbs_.data(), shorter.limbs_.size());
+        r.trim();
+        return r;
+    }
+
+    // a - b for a >= b
+    friend BigUnsigned operator-(const BigUnsigned& a, const BigUnsigned& b)
+    {
+        BigUnsigned r = a;
+        detail::subtractLimbs(r.limbs_.data(), r.limbs_.size(), b.limbs_.data(), b.limbs_.size());
+        r.trim();
+        return r;
+    }
+
+    friend BigUnsigned operator*(const BigUnsigned& a, const BigUnsigned& b)
+    {
+        BigUnsigned r;
+        if (a.isZero() || b.isZero())
+            return r;
+        r.limbs_.resize(a.limbs_.size() + b.limbs_.size());
+        detail::multiplyLimbs(a.limbs_.data(), a.limbs_.size(), b.limbs_.data(), b.limbs_.size(), r.limbs_.data());
+        r.trim();
+        return r;
+    }
+
+private:
+    void trim()
+    {
+        while (!limbs_.empty() && limbs_.back() == 0)
+            limbs_.pop_back();
+    }
+
+    std::vector<std::uint32_t> limbs_; // no high zero limbs; empty is zero
+};
+
+// F(n) mod 2^64: exact for n <= FIBONACCI_MAX_EXACT
+inline std::uint64_t fibonacci(std::uint64_t n)
+{
+    return detail::fibonacciPair<std::uint64_t>(
+               n, 1, [](std::uint64_t a, std::uint64_t b) { return a * b; },
+               [](std::uint64_t a, std::uint64_t b) { return a + b; },
+               [](std::uint64_t a, std::uint64_t b) { return a - b; })
+        .first;
+}
+
+// F(n) mod m, m > 0
+inline std::uint64_t fibonacciMod(std::uint64_t n, std::uint64_t m)
+{
+    auto add = [m](std::uint64_t a, std::uint64_t b) { return a >= m - b ? a - (m - b) : a + b; };
+    auto sub = [m](std::uint64_t a, std::uint64_t b) { return a >= b ? a - b : a + (m - b); };
+    // Odd moduli multiply in Montgomery form, without a division
+    if (m & 1) {
+        const Montgomery64 mont(m);
+        return mont.reduce(detail::fibonacciPair<std::uint64_t>(
+                                n, mont.one, [&mont](std::uint64_t a, std::uint64_t b) { return mont.mul(a, b); },
+                                add, sub)
+                               .first);
+    }
+    // Below 2^32 the products fit in a word
+    if (m <= (std::uint64_t(1) << 32))
+        return detail::fibonacciPair<std::uint64_t>(
+                   n, 1, [m](std::uint64_t a, std::uint64_t b) { return a * b % m; }, add, sub)
+            .first;
+    return detail::fibonacciPair<std::uint64_t>(
+               n, 1, [m](std::uint64_t a, std::uint64_t b) { return mulMod(a, b, m); }, add, sub)
+        .first;
+}
+
+// F(n) exactly; the products of long steps are split over the pool when
+// it is set
+inline BigUnsigned fibonacciBig(std::uint64_t n, ThreadPool* pool = nullptr)
+{
+    BigUnsigned a, b(1); // F(k), F(k + 1), from k = 0
+    for (int shift = n ? 63 - __builtin_clzll(n) : -1; shift >= 0; shift--) {
+        const bool odd = (n >> shift) & 1;
+        // The last step needs F(2k) or F(2k + 1) only
+        const bool wantEven = shift > 0 || !odd, wantOdd = shift > 0 || odd;
+        BigUnsigned products[3];
+        auto work = [&](unsigned, std::size_t begin, std::size_t end) {
+            for (std::size_t p = begin; p < end; p++) {
+                if (p == 0 && wantEven)
+                    products[0] = a * (b + b - a);
+                else if (p == 1 && wantOdd)
+                    products[1] = a * a;
+                else if (p == 2 && wantOdd)
+                    products[2] = b * b;
+            }
+        };
+        if (pool && a.limbs().size() >= FIBONACCI_PARALLEL_MIN_LIMBS)
+            pool->parallelFor(3, 1, work);
+        else
+            work(0, 0, 3);
+        BigUnsigned even = std::move(products[0]);
+        BigUnsigned oddTerm = products[1] + products[2];
+        if (odd) {
+            b = even + oddTerm;
+            a = std::move(oddTerm);
+        } else {
+            a = std::move(even);
+            b = std::move(oddTerm);
+        }
+    }
+    return a;
+}
+
+// Upper bound on the bytes writeFibonacciSeries(n) writes: F(i) has at
+// most i log10(phi) + 1 digits
+inline std::size_t fibonacciSeriesBound(std::size_t n)
+{
+    const double log10Phi = 0.20898764024997873;
+    const double terms = static_cast<double>(n);
+    return static_cast<std::size_t>(log10Phi / 2 * terms * terms) + 2 * n + 16;
+}
+
+// F(0), .., F(n - 1), each followed by a space as the original prints them;
+// out holds fibonacciSeriesBound(n) bytes. Returns the bytes written.
+inline std::size_t writeFibonacciSeries(std::size_t n, char* out)
+{
+    const double log10Phi = 0.20898764024997873;
+    const std::size_t maxLimbs = static_cast<std::size_t>(log10Phi * static_cast<double>(n)) / BIG_BASE_DIGITS + 2;
+    // F(i) and F(i + 1), zero-padded to the longest term
+    std::vector<std::uint32_t> current(maxLimbs), next(maxLimbs);
+    std::size_t currentSize = 1, nextSize = 1;
+    next[0] = 1;
+    char* const start = out;
+    for (std::size_t i = 0; i < n; i++) {
+        out = detail::writeTopLimb(out, current[currentSize - 1]);
+        for (std::size_t j = currentSize - 1; j-- > 0;)
+            out = detail::writeLimb(out, current[j]);
+        *out++ = ' ';
+        // F(i + 2) = F(i) + F(i + 1) replaces F(i)
+        detail::addLimbs(current.data(), nextSize + 1, next.data(), nextSize);
+        currentSize = current[nextSize] ? nextSize + 1 : nextSize;
+        std::swap(current, next);
+        std::swap(currentSize, nextSize);
+    }
+    return static_cast<std::size_t>(out - start);
+}
+
+// Appends the first n terms to out, in one allocation
+inline void appendFibonacciSeries(std::size_t n, std::string& out)
+{
+    const std::size_t at = out.size();
+    out.resize(at + fibonacciSeriesBound(n));
+    out.resize(at + writeFibonacciSeries(n, &out[at]));
+}
+
+} // namespace algo
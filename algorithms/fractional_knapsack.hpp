@@ -0,0 +1,190 @@
+// Fractional knapsack without sorting every item. The original
+// fractionalKnapsack() qsorts the whole Item array by a float pByw, then
+// takes items in that order until the capacity is full, with a printf per
+// item taken.
+//
+// Only the split item matters: the one the capacity runs out inside. The
+// items with a higher ratio are taken whole, in any order, and the rest are
+// left out. FractionalMode::Select finds the split item by weighted
+// quickselect. It partitions around a median-of-three ratio, compares the
+// weight of the higher side with the capacity left, and continues in one
+// side only. Expected cost is O(n); past 2 log2 n rounds the remaining
+// range is sorted instead. FractionalMode::PartialSort also sorts the items
+// taken, so they come out in the original's order, for O(n + k log k).
+//
+// Items are passed as separate weight and profit columns. Ratios are
+// doubles, and whole items are summed exactly in 64 bits. Nothing is
+// printed: the solution names the items, and takenItem() lists them for
+// the caller to log.
+//
+// fractionalKnapsackBatch() solves many problems, each in its own mode, and
+// each worker reuses one thread-local scratch buffer.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "quick_sort.hpp"
+#include "thread_pool.hpp"
+
+namespace algo {
+
+enum class FractionalMode { Select, PartialSort };
+
+// Ranges this short are sorted and scanned instead of partitioned
+const std::size_t FRACTIONAL_SELECT_CUTOFF = 32;
+
+// weight[i] > 0 and profit[i] of item i, for i < n < 2^32
+struct FractionalItems {
+    const int* weight;
+    const int* profit;
+    std::size_t n;
+};
+
+struct FractionalSolution {
+    double profit = 0;
+    std::size_t whole = 0;  // number of items taken whole
+    std::size_t split = 0;  // the item taken in part, n if none
+    double fraction = 0;    // the share of it taken, in (0, 1)
+};
+
+struct FractionalProblem {
+    FractionalItems items;
+    long long capacity;
+    FractionalMode mode = FractionalMode::Select;
+};
+
+namespace detail {
+
+// 16 bytes, so a partition swap moves one record instead of four columns
+struct RatioItem {
+    double ratio;
+    int weight;
+    std::uint32_t id;
+};
+
+// Descending ratio, ties by item index
+inline bool higherRatio(const RatioItem& a, const RatioItem& b)
+{
+    return a.ratio > b.ratio || (a.ratio == b.ratio && a.id < b.id);
+}
+
+// Hoare partition of a[lo..hi), hi - lo >= 3, around the median of three
+// ratios. Returns m with ratios >= the pivot in [lo, m), <= in [m, hi);
+// both are non-empty.
+inline std::size_t ratioPartition(RatioItem* a, std::size_t lo, std::size_t hi)
+{
+    double x = a[lo].ratio, y = a[lo + (hi - lo) / 2].ratio, z = a[hi - 1].ratio;
+    double pivot = std::max(std::min(x, y), std::min(std::max(x, y), z));
+    std::size_t i = lo, j = hi - 1;
+    for (;;) {
+        while (a[i].ratio > pivot)
+            i++;
+        while (a[j].ratio < pivot)
+            j--;
+        if (i >= j)
+            return j + 1;
+        std::swap(a[i++], a[j--]);
+    }
+}
+
+} // namespace detail
+
+// Solves problems one after another on the same scratch buffer, so a
+// warmed-up solver does not allocate.
+class FractionalKnapsack {
+public:
+    FractionalSolution solve(const FractionalItems& items, long long capacity,
+                             FractionalMode mode = FractionalMode::Select)
+    {
+        const std::size_t n = items.n;
+        FractionalSolution s;
+        s.split = n;
+        work_.resize(n);
+        detail::RatioItem* a = work_.data();
+        for (std::size_t i = 0; i < n; i++)
+            a[i] = {static_cast<double>(items.profit[i]) / items.weight[i], items.weight[i],
+                    static_cast<std::uint32_t>(i)};
+        if (n == 0 || capacity <= 0)
+            return s;
+
+        // [0, lo) fits whole and [hi, n) is left out; the split item, if
+        // any, is in [lo, hi).
+        std::size_t lo = 0, hi = n;
+        long long remaining = capacity;
+        for (int depth = detail::depthLimit(n); hi - lo > FRACTIONAL_SELECT_CUTOFF && depth > 0; depth--) {
+            std::size_t m = detail::ratioPartition(a, lo, hi);
+            long long w = 0;
+            for (std::size_t i = lo; i < m; i++)
+                w += a[i].weight;
+            if (w > remaining) {
+                hi = m;
+            } else {
+                remaining -= w;
+                lo = m;
+            }
+        }
+        quickSort(a + lo, hi - lo, detail::higherRatio);
+        std::size_t k = lo;
+        while (k < hi && a[k].weight <= remaining)
+            remaining -= a[k++].weight;
+        if (mode == FractionalMode::PartialSort)
+            quickSort(a, k, detail::higherRatio);
+
+        long long whole = 0;
+        for (std::size_t i = 0; i < k; i++)
+            whole += items.profit[a[i].id];
+        s.whole = k;
+        s.profit = static_cast<double>(whole);
+        if (k < n && remaining > 0) {
+            s.split = a[k].id;
+            s.fraction = static_cast<double>(remaining) / a[k].weight;
+            s.profit += s.fraction * items.profit[s.split];
+        }
+        return s;
+    }
+
+    // The i-th item taken whole by the last solve(), i < whole; in
+    // descending ratio order after PartialSort
+    std::size_t takenItem(std::size_t i) const { return work_[i].id; }
+
+private:
+    std::vector<detail::RatioItem> work_;
+};
+
+namespace detail {
+
+inline FractionalKnapsack& fractionalSolver()
+{
+    thread_local FractionalKnapsack solver;
+    return solver;
+}
+
+} // namespace detail
+
+inline FractionalSolution fractionalKnapsack(const int* weight, const int* profit, std::size_t n, long long capacity,
+                                             FractionalMode mode = FractionalMode::Select)
+{
+    return detail::fractionalSolver().solve({weight, profit, n}, capacity, mode);
+}
+
+// solutions[p] for every problems[p] in problems[p].mode, split over the
+// pool when it is set
+inline void fractionalKnapsackBatch(const FractionalProblem* problems, std::size_t count,
+                                    FractionalSolution* solutions, ThreadPool* pool = nullptr)
+{
+    auto work = [&](unsigned, std::size_t b, std::size_t e) {
+        FractionalKnapsack& solver = detail::fractionalSolver();
+        for (std::size_t p = b; p < e; p++)
+            solutions[p] = solver.solve(problems[p].items, problems[p].capacity, problems[p].mode);
+    };
+    if (pool)
+        pool->parallelFor(count, 0, work);
+    else
+        work(0, 0, count);
+}
+
+} // namespace algo
@@ -0,0 +1,93 @@
+// Edge list and compressed-sparse-row (CSR) graph shared by the graph algorithms.
+// Vertices are 0..n-1; the out-edges of u are adj[offsets[u] .. offsets[u+1]).
+// The algorithms take a CsrView, which a CsrGraph converts to and a mapped
+// graph file (binary_file.hpp) provides without a copy.
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "span.hpp"
+
+namespace algo {
+
+struct Edge {
+    int u;
+    int v;
+    int w;
+};
+
+struct CsrGraph {
+    int n = 0;
+    std::vector<std::int64_t> offsets; // n + 1 entries
+    std::vector<int> adj;              // edge targets
+    std::vector<int> weight;           // edge weights, parallel to adj
+
+    std::int64_t edgeCount() const { return offsets.empty() ? 0 : offsets[n]; }
+};
+
+// The arrays of a CSR graph, owned elsewhere
+struct CsrView {
+    int n = 0;
+    Span<const std::int64_t> offsets; // n + 1 entries
+    Span<const int> adj;
+    Span<const int> weight;
+
+    CsrView() = default;
+    CsrView(int vertices, Span<const std::int64_t> rowOffsets, Span<const int> targets, Span<const int> weights)
+        : n(vertices), offsets(rowOffsets), adj(targets), weight(weights)
+    {
+    }
+    CsrView(const CsrGraph& g) : n(g.n), offsets(g.offsets), adj(g.adj), weight(g.weight) {}
+
+    std::int64_t edgeCount() const { return offsets.empty() ? 0 : offsets[n]; }
+};
+
+// Build a CSR graph from an edge list with one counting pass and one fill pass.
+// With undirected set, every edge is stored in both directions.
+inline CsrGraph buildCsr(int n, const std::vector<Edge>& edges, bool undirected = false)
+{
+    CsrGraph g;
+    g.n = n;
+    g.offsets.assign(static_cast<std::size_t>(n) + 1, 0);
+
+    for (const Edge& e : edges) {
+        g.offsets[e.u + 1]++;
+        if (undirected)
+            g.offsets[e.v + 1]++;
+    }
+    for (int i = 0; i < n; i++)
+        g.offsets[i + 1] += g.offsets[i];
+
+    g.adj.resize(static_cast<std::size_t>(g.offsets[n]));
+    g.weight.resize(g.adj.size());
+
+    // Keep edges in input order within each row so results are reproducible
+    std::vector<std::int64_t> next(g.offsets.begin(), g.offsets.end() - 1);
+    for (const Edge& e : edges) {
+        std::int64_t k = next[e.u]++;
+        g.adj[k] = e.v;
+        g.weight[k] = e.w;
+        if (undirected) {
+            k = next[e.v]++;
+            g.adj[k] = e.u;
+            g.weight[k] = e.w;
+        }
+    }
+    return g;
+}
+
+// Convert a dense adjacency matrix to CSR. As in dijkstra(), a 0 entry
+// means "no edge". stride is the row length of the matrix (MAX in the
+// original program).
+inline CsrGraph csrFromMatrix(const int* G, int n, int stride)
+{
+    std::vector<Edge> edges;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            if (G[i * stride + j] != 0)
+                edges.push_back({i, j, G[i * stride + j]});
+    return buildCsr(n, edges);
+}
+
+} // namespace algo
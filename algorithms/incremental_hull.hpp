@@ -0,0 +1,155 @@
+// Convex hull of a growing point set. Re-running convexHull() after every
+// new point costs O(n log n) per update. Here the upper and lower chains are
+// kept in balanced search trees keyed by x.
+//
+// insert() finds the point's neighbours on each chain. If the point is
+// strictly outside a chain, it goes into that chain, and the neighbours it
+// makes non-convex are erased on both sides. Each point is erased at most
+// once, so an insert is amortised O(log n). contains() is one tree lookup
+// per chain.
+//
+// hull() returns the vertices in convexHull()'s order: counter-clockwise
+// from the smallest (x, y), without collinear points. The result is cached
+// and only rebuilt after an insert has changed the hull. forEachVertex()
+// walks the trees directly, without a copy.
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <vector>
+
+#include "convex_hull.hpp"
+
+namespace algo {
+
+namespace detail {
+
+// One monotone chain: for each x the outermost y, and only the x whose
+// points are strict vertices. Upper keeps the largest y and turns clockwise
+// left to right; the lower chain is its mirror image.
+template <bool Upper>
+class HullChain {
+public:
+    // True if p is outside the chain's side of the hull
+    bool outside(const Point& p) const
+    {
+        auto next = chain_.lower_bound(p.x);
+        if (next != chain_.end() && next->first == p.x)
+            return beyond(p.y, next->second);
+        if (next == chain_.end() || next == chain_.begin())
+            return true;
+        auto prev = std::prev(next);
+        return sign() * turn(point(prev), point(next), p) > 0;
+    }
+
+    // Add p if it is outside; returns whether the chain changed
+    bool insert(const Point& p)
+    {
+        if (!outside(p))
+            return false;
+        auto at = chain_.insert_or_assign(p.x, p.y).first;
+        // The right neighbour is redundant if it does not turn away from p
+        for (auto next = std::next(at); next != chain_.end();) {
+            auto after = std::next(next);
+            if (after == chain_.end() || sign() * turn(p, point(next), point(after)) < 0)
+                break;
+            next = chain_.erase(next);
+        }
+        while (at != chain_.begin()) {
+            auto prev = std::prev(at);
+            if (prev == chain_.begin() || sign() * turn(point(std::prev(prev)), point(prev), p) < 0)
+                break;
+            chain_.erase(prev);
+        }
+        return true;
+    }
+
+    bool empty() const { return chain_.empty(); }
+    std::size_t size() const { return chain_.size(); }
+
+    using Iterator = typename std::map<int, int>::const_iterator;
+    Iterator begin() const { return chain_.begin(); }
+    Iterator end() const { return chain_.end(); }
+    static Point point(Iterator it) { return {it->first, it->second}; }
+
+private:
+    static int sign() { return Upper ? 1 : -1; }
+    static bool beyond(int y, int chainY) { return Upper ? y > chainY : y < chainY; }
+
+    std::map<int, int> chain_;
+};
+
+} // namespace detail
+
+class IncrementalHull {
+public:
+    IncrementalHull() = default;
+
+    // Starts from the hull of points, built by convexHull()
+    explicit IncrementalHull(std::vector<Point> points, TaskPool* pool = nullptr)
+    {
+        for (const Point& p : convexHull(std::move(points), pool))
+            insert(p);
+    }
+
+    // Add p; returns whether the hull changed, i.e. p was outside it
+    bool insert(const Point& p)
+    {
+        bool changed = lower_.insert(p);
+        changed = upper_.insert(p) || changed;
+        dirty_ = dirty_ || changed;
+        return changed;
+    }
+
+    // True if p is inside the hull or on its boundary
+    bool contains(const Point& p) const { return !lower_.empty() && !lower_.outside(p) && !upper_.outside(p); }
+
+    bool empty() const { return lower_.empty(); }
+
+    // Number of hull vertices
+    std::size_t size() const
+    {
+        std::size_t n = 0;
+        forEachVertex([&n](const Point&) { n++; });
+        return n;
+    }
+
+    // fn(vertex) in hull() order, read straight from the chains
+    template <class Fn>
+    void forEachVertex(Fn fn) const
+    {
+        if (lower_.empty())
+            return;
+        const Point first = detail::HullChain<false>::point(lower_.begin());
+        Point last = first;
+        for (auto it = lower_.begin(); it != lower_.end(); ++it)
+            fn(last = detail::HullChain<false>::point(it));
+        // The chains share their end points when the extreme x hold one point
+        for (auto it = upper_.end(); it != upper_.begin();) {
+            const Point p = detail::HullChain<true>::point(--it);
+            if (p != last && p != first)
+                fn(p);
+        }
+    }
+
+    // The vertices counter-clockwise from the smallest (x, y), rebuilt only
+    // after the hull has changed
+    const std::vector<Point>& hull() const
+    {
+        if (dirty_) {
+            cache_.clear();
+            forEachVertex([this](const Point& p) { cache_.push_back(p); });
+            dirty_ = false;
+        }
+        return cache_;
+    }
+
+private:
+    detail::HullChain<false> lower_;
+    detail::HullChain<true> upper_;
+    mutable std::vector<Point> cache_;
+    mutable bool dirty_ = false;
+};
+
+} // namespace algo
@@ -0,0 +1,199 @@
+// Insertion sort, used directly for small arrays and as the small-run
+// kernel of the merge and quick sorts. The original checks j >= 0 on every
+// step of its shift loop. Here the checks are taken out of the inner loops:
+//  - insertionSort() compares each element with the front one first. A new
+//    minimum moves the whole sorted prefix up in one block move; any other
+//    element stops on the front element at the latest, so its shift loop is
+//    unguarded. Stable.
+//  - unguardedInsertionSort() skips that pass, for ranges known to have an
+//    element no greater than any of theirs at array[-1]. Quick sort
+//    partitions other than the leftmost one have one.
+//  - binaryInsertionSort() finds each insertion point by binary search and
+//    shifts the run in one block move: memmove for trivially copyable
+//    types. About log2 i compares per element rather than i / 2, for
+//    expensive comparators. Stable.
+//  - networkSort() sorts up to SORT_NETWORK_MAX elements with a fixed
+//    compare-exchange network. The network is Batcher's odd-even merge sort
+//    for n inputs, generated at compile time. It has no data-dependent
+//    branches for trivially copyable types, and it is not stable. The
+//    std::array overload fixes n at compile time and is constexpr.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "counters.hpp"
+#include "span.hpp"
+
+namespace algo {
+
+const std::size_t SORT_NETWORK_MAX = 16;
+
+template <class T, class Compare = std::less<T>>
+void unguardedInsertionSort(T* array, std::size_t n, Compare comp = Compare())
+{
+    auto less = countComparisons(comp);
+    for (std::size_t i = 0; i < n; i++) {
+        T element = std::move(array[i]);
+        T* hole = array + i;
+        // Some element before the hole is not greater than element, so the
+        // loop stops without a bounds check.
+        while (less(element, hole[-1])) {
+            *hole = std::move(hole[-1]);
+            hole--;
+        }
+        *hole = std::move(element);
+        ALGO_COUNT(moves, array + i - hole);
+    }
+}
+
+template <class T, class Compare = std::less<T>>
+void insertionSort(T* array, std::size_t n, Compare comp = Compare())
+{
+    auto less = countComparisons(comp);
+    for (std::size_t i = 1; i < n; i++) {
+        if (less(array[i], array[0])) {
+            // A new minimum: the whole prefix moves up one in a block
+            T element = std::move(array[i]);
+            std::move_backward(array, array + i, array + i + 1);
+            array[0] = std::move(element);
+            ALGO_COUNT(moves, i);
+        } else {
+            unguardedInsertionSort(array + i, 1, less);
+        }
+    }
+}
+
+template <class T, class Compare = std::less<T>>
+void binaryInsertionSort(T* array, std::size_t n, Compare comp = Compare())
+{
+    auto less = countComparisons(comp);
+    for (std::size_t i = 1; i < n; i++) {
+        if (!less(array[i], array[i - 1]))
+            continue;
+        // After the last element not greater than array[i]
+        T* at = std::upper_bound(array, array + i, array[i], less);
+        ALGO_COUNT(moves, array + i - at);
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            T element = array[i];
+            std::memmove(static_cast<void*>(at + 1), static_cast<const void*>(at), (array + i - at) * sizeof(T));
+            *at = element;
+        } else {
+            T element = std::move(array[i]);
+            std::move_backward(at, array + i, array + i + 1);
+            *at = std::move(element);
+        }
+    }
+}
+
+namespace detail {
+
+struct SortNetwork {
+    unsigned char lo[64], hi[64];
+    std::size_t size = 0;
+};
+
+// Batcher's odd-even merge sort on n inputs: every comparator (lo, hi) puts
+// the smaller element at lo.
+constexpr SortNetwork batcherNetwork(std::size_t n)
+{
+    SortNetwork net{};
+    for (std::size_t p = 1; p < n; p <<= 1)
+        for (std::size_t k = p; k >= 1; k >>= 1)
+            for (std::size_t j = k % p; j + k < n; j += 2 * k)
+                for (std::size_t i = 0; i < k && i + j + k < n; i++)
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                        net.lo[net.size] = static_cast<unsigned char>(i + j);
+                        net.hi[net.size] = static_cast<unsigned char>(i + j + k);
+                        net.size++;
+                    }
+    return net;
+}
+
+template <class T, class Compare>
+constexpr void compareExchange(T& a, T& b, Compare comp)
+{
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        // Both selects lower to conditional moves
+        const T x = a, y = b;
+        const bool swap = comp(y, x);
+        a = swap ? y : x;
+        b = swap ? x : y;
+    } else if (comp(b, a)) {
+        std::swap(a, b);
+    }
+}
+
+template <std::size_t N, class T, class Compare, std::size_t... I>
+constexpr void applyNetwork(T* array, Compare comp, std::index_sequence<I...>)
+{
+    constexpr SortNetwork net = batcherNetwork(N);
+    (compareExchange(array[net.lo[I]], array[net.hi[I]], comp), ...);
+}
+
+template <std::size_t N, class T, class Compare>
+constexpr void networkSortN(T* array, Compare comp)
+{
+    applyNetwork<N>(array, comp, std::make_index_sequence<batcherNetwork(N).size>());
+}
+
+} // namespace detail
+
+// n <= SORT_NETWORK_MAX; not stable
+template <class T, class Compare = std::less<T>>
+void networkSort(T* array, std::size_t n, Compare comp = Compare())
+{
+    auto less = countComparisons(comp);
+    switch (n) {
+    case 2: return detail::networkSortN<2>(array, less);
+    case 3: return detail::networkSortN<3>(array, less);
+    case 4: return detail::networkSortN<4>(array, less);
+    case 5: return detail::networkSortN<5>(array, less);
+    case 6: return detail::networkSortN<6>(array, less);
+    case 7: return detail::networkSortN<7>(array, less);
+    case 8: return detail::networkSortN<8>(array, less);
+    case 9: return detail::networkSortN<9>(array, less);
+    case 10: return detail::networkSortN<10>(array, less);
+    case 11: return detail::networkSortN<11>(array, less);
+    case 12: return detail::networkSortN<12>(array, less);
+    case 13: return detail::networkSortN<13>(array, less);
+    case 14: return detail::networkSortN<14>(array, less);
+    case 15: return detail::networkSortN<15>(array, less);
+    case 16: return detail::networkSortN<16>(array, less);
+    default: return;
+    }
+}
+
+// The network for N elements inlined as straight-line code
+template <class T, std::size_t N, class Compare = std::less<T>>
+constexpr void networkSort(std::array<T, N>& array, Compare comp = Compare())
+{
+    static_assert(N <= SORT_NETWORK_MAX, "no sorting network for this many elements");
+    if constexpr (N > 1)
+        detail::networkSortN<N>(array.data(), comp);
+}
+
+template <class T, class Compare = std::less<T>>
+void insertionSort(Span<T> s, Compare comp = Compare())
+{
+    insertionSort(s.data(), s.size(), comp);
+}
+
+template <class T, class Compare = std::less<T>>
+void binaryInsertionSort(Span<T> s, Compare comp = Compare())
+{
+    binaryInsertionSort(s.data(), s.size(), comp);
+}
+
+template <class T, class Compare = std::less<T>>
+void networkSort(Span<T> s, Compare comp = Compare())
+{
+    networkSort(s.data(), s.size(), comp);
+}
+
+} // namespace algo
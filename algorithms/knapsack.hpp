@@ -0,0 +1,169 @@
+// Space-optimised 0/1 knapsack. The original knapsack() keeps the whole
+// knap[n + 1][W + 1] table as a stack VLA; every row only depends on the
+// previous one, so a single row of W + 1 values updated from w = W down to
+// wt[i] gives the same answer in O(W) memory.
+//
+// Reconstructing the chosen items needs more than the last row:
+//  - Bitmap keeps one "item i improved capacity w" bit per cell, n(W + 1)/8
+//    bytes, and walks back through it like the original table.
+//  - DivideAndConquer (Hirschberg-style) keeps O(W) memory: solve the first
+//    and second half of the items separately, find the capacity split where
+//    the two halves' best values add up to the optimum, and recurse.
+//    It costs about log2 n times the work of the value-only DP.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bitset.hpp"
+#include "counters.hpp"
+#include "span.hpp"
+
+namespace algo {
+
+enum class KnapsackReconstruction { Auto, Bitmap, DivideAndConquer };
+
+// Auto uses the bitmap while it stays below this many bytes.
+const std::size_t KNAPSACK_BITMAP_LIMIT = std::size_t(256) << 20;
+
+struct KnapsackSolution {
+    long long value = 0;
+    std::vector<int> items; // indices of the chosen items, ascending
+};
+
+namespace detail {
+
+// Fold items [lo, hi) into the row dp[0..W], which holds the best value for
+// every capacity using the items folded in so far.
+inline void knapsackFold(long long* dp, int W, const int wt[], const int val[], int lo, int hi)
+{
+    for (int i = lo; i < hi; i++) {
+        const int w0 = wt[i];
+        const long long v = val[i];
+        ALGO_COUNT(cells, std::max(0, W - w0 + 1));
+        for (int w = W; w >= w0; w--)
+            dp[w] = std::max(dp[w], dp[w - w0] + v);
+    }
+}
+
+inline void knapsackDivide(int W, const int wt[], const int val[], int lo, int hi, std::vector<long long>& f,
+                           std::vector<long long>& g, std::vector<int>& items)
+{
+    ALGO_DEPTH_SCOPE();
+    if (hi - lo == 1) {
+        if (wt[lo] <= W && val[lo] > 0)
+            items.push_back(lo);
+        return;
+    }
+    int mid = lo + (hi - lo) / 2;
+    std::fill(f.begin(), f.begin() + W + 1, 0);
+    knapsackFold(f.data(), W, wt, val, lo, mid);
+    std::fill(g.begin(), g.begin() + W + 1, 0);
+    knapsackFold(g.data(), W, wt, val, mid, hi);
+
+    int best = 0;
+    for (int c = 1; c <= W; c++)
+        if (f[c] + g[W - c] > f[best] + g[W - best])
+            best = c;
+    knapsackDivide(best, wt, val, lo, mid, f, g, items);
+    knapsackDivide(W - best, wt, val, mid, hi, f, g, items);
+}
+
+} // namespace detail
+
+// Maximum value for capacity W, as knapsack() in Knapsack.pdf, in O(W) memory.
+inline long long knapsack(int W, const int wt[], const int val[], int n)
+{
+    if (W < 0)
+        return 0;
+    std::vector<long long> dp(static_cast<std::size_t>(W) + 1, 0);
+    detail::knapsackFold(dp.data(), W, wt, val, 0, n);
+    return dp[W];
+}
+
+inline KnapsackSolution knapsackWithItems(int W, const int wt[], const int val[], int n,
+                                          KnapsackReconstruction mode = KnapsackReconstruction::Auto)
+{
+    KnapsackSolution solution;
+    if (W < 0 || n <= 0)
+        return solution;
+    const std::size_t row = static_cast<std::size_t>(W) + 1;
+
+    if (mode == KnapsackReconstruction::Auto)
+        mode = static_cast<std::size_t>(n) * row / 8 <= KNAPSACK_BITMAP_LIMIT ? KnapsackReconstruction::Bitmap
+                                                                             : KnapsackReconstruction::DivideAndConquer;
+
+    if (mode == KnapsackReconstruction::DivideAndConquer) {
+        std::vector<long long> f(row), g(row);
+        detail::knapsackDivide(W, wt, val, 0, n, f, g, solution.items);
+        for (int i : solution.items)
+            solution.value += val[i];
+        return solution;
+    }
+
+    std::vector<long long> dp(row, 0);
+    DynamicBitset took(static_cast<std::size_t>(n) * row);
+    for (int i = 0; i < n; i++) {
+        const int w0 = wt[i];
+        const long long v = val[i];
+        const std::size_t base = static_cast<std::size_t>(i) * row;
+        ALGO_COUNT(cells, std::max(0, W - w0 + 1));
+        for (int w = W; w >= w0; w--) {
+            if (dp[w - w0] + v > dp[w]) {
+                dp[w] = dp[w - w0] + v;
+                took.set(base + w);
+            }
+        }
+    }
+    solution.value = dp[W];
+
+    int w = W;
+    for (int i = n - 1; i >= 0; i--) {
+        if (took.test(static_cast<std::size_t>(i) * row + w)) {
+            solution.items.push_back(i);
+            w -= wt[i];
+        }
+    }
+    std::reverse(solution.items.begin(), solution.items.end());
+    return solution;
+}
+
+// Feasibility mode for the unit-value case (value == weight): bit c of the
+// result is set when some subset of the items weighs exactly c, for
+// c = 0..W. One word-parallel shift-or per item, O(n W / 64).
+inline DynamicBitset knapsackReachable(int W, const int wt[], int n)
+{
+    DynamicBitset reach(W >= 0 ? static_cast<std::size_t>(W) + 1 : 0);
+    if (W < 0)
+        return reach;
+    reach.set(0);
+    for (int i = 0; i < n; i++)
+        if (wt[i] <= W) {
+            reach.orShiftedLeft(static_cast<std::size_t>(wt[i]));
+            ALGO_COUNT(cells, W + 1);
+        }
+    return reach;
+}
+
+// Heaviest load <= W that the items can fill exactly.
+inline long long knapsackMaxFill(int W, const int wt[], int n)
+{
+    return knapsackReachable(W, wt, n).highestSetAtOrBelow(W >= 0 ? W : 0);
+}
+
+// The modes above over weight and value columns; a vector converts to a
+// Span implicitly. Items past the shorter column are ignored.
+inline long long knapsack(int W, Span<const int> wt, Span<const int> val)
+{
+    return knapsack(W, wt.data(), val.data(), static_cast<int>(std::min(wt.size(), val.size())));
+}
+
+inline KnapsackSolution knapsackWithItems(int W, Span<const int> wt, Span<const int> val,
+                                          KnapsackReconstruction mode = KnapsackReconstruction::Auto)
+{
+    return knapsackWithItems(W, wt.data(), val.data(), static_cast<int>(std::min(wt.size(), val.size())), mode);
+}
+
+} // namespace algo
@@ -0,0 +1,108 @@
+// Sort-based Kruskal minimum spanning tree, O(E + V α(V)) after an O(E)
+// radix sort of the edge weights. Replaces the cost[9][9] matrix sweep
+// and the uncompressed find()/uni() of the original program.
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "graph.hpp"
+#include "radix_sort.hpp"
+
+namespace algo {
+
+// Disjoint-set forest with path halving and union by rank.
+class DisjointSet {
+public:
+    explicit DisjointSet(int n = 0) { reset(n); }
+
+    void reset(int n)
+    {
+        parent_.resize(n);
+        rank_.assign(n, 0);
+        for (int i = 0; i < n; i++)
+            parent_[i] = i;
+    }
+
+    int find(int i)
+    {
+        while (parent_[i] != i) {
+            parent_[i] = parent_[parent_[i]];
+            i = parent_[i];
+        }
+        return i;
+    }
+
+    // Merge the sets holding i and j; returns false if they were already one.
+    bool uni(int i, int j)
+    {
+        i = find(i);
+        j = find(j);
+        if (i == j)
+            return false;
+        if (rank_[i] < rank_[j])
+            std::swap(i, j);
+        parent_[j] = i;
+        if (rank_[i] == rank_[j])
+            rank_[i]++;
+        return true;
+    }
+
+private:
+    std::vector<int> parent_;
+    std::vector<unsigned char> rank_;
+};
+
+// Stable sort of edges by weight: radixSortPairs() on the weights with the
+// edges as payload.
+inline void sortEdgesByWeight(std::vector<Edge>& edges)
+{
+    std::vector<int> weights(edges.size());
+    for (std::size_t i = 0; i < edges.size(); i++)
+        weights[i] = edges[i].w;
+    radixSortPairs(weights.data(), edges.data(), edges.size());
+}
+
+struct MstResult {
+    std::vector<Edge> edges; // in the order they were added
+    long long mincost = 0;
+};
+
+// Minimum spanning forest of vertices 0..n-1. Equal weights are taken in
+// input order, so edges listed row by row from the cost matrix come out in
+// the same order as the original matrix scan.
+inline MstResult kruskal(int n, std::vector<Edge> edges)
+{
+    sortEdgesByWeight(edges);
+
+    MstResult result;
+    result.edges.reserve(n > 0 ? n - 1 : 0);
+    DisjointSet sets(n);
+    for (const Edge& e : edges) {
+        if (sets.uni(e.u, e.v)) {
+            result.edges.push_back(e);
+            result.mincost += e.w;
+            if (static_cast<int>(result.edges.size()) == n - 1)
+                break;
+        }
+    }
+    return result;
+}
+
+// Edge list of an undirected cost matrix read the way the original
+// program does: entries of 0 (or noEdge) are missing edges, and each
+// pair is taken once from the upper triangle.
+inline std::vector<Edge> edgesFromCostMatrix(const int* cost, int n, int stride, int noEdge = 999)
+{
+    std::vector<Edge> edges;
+    for (int i = 0; i < n; i++)
+        for (int j = i + 1; j < n; j++) {
+            int w = cost[i * stride + j];
+            if (w != 0 && w != noEdge)
+                edges.push_back({i, j, w});
+        }
+    return edges;
+}
+
+} // namespace algo
@@ -0,0 +1,284 @@
+// Longest Common Subsequence for long inputs. The original lcs() keeps
+// int L[m + 1][n + 1] on the stack, which is out of the question for
+// 10^5 - 10^6 character sequences. Three modes:
+//  - lcsLength(): bit-parallel (Allison-Dizon / Crochemore et al.) row
+//    update, V' = (V + (V & M[c])) | (V & ~M[c]), 64 DP cells per word op
+//    and O(n / 64) memory.
+//  - lcsHirschberg(): Hirschberg's divide and conquer, returns the
+//    subsequence in linear space; its forward and backward rows come from
+//    the same bit-parallel update.
+//  - lcs() / parallelLcs(): the full table and traceback of the original,
+//    on the heap, the parallel one filled tile by tile along anti-diagonals.
+// lcsLength() on Spans also takes sequences of other element types, such
+// as tokens, with a rolling-row DP.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "counters.hpp"
+#include "span.hpp"
+#include "thread_pool.hpp"
+
+namespace algo {
+
+// Below this many cells Hirschberg solves a piece with the full table.
+const long long LCS_TABLE_CUTOFF = 1 << 14;
+// Side of the square tiles of the wavefront
+const int LCS_TILE = 256;
+
+namespace detail {
+
+// Bit j of the row vector stands for column j of b. After folding in the
+// characters of a, column j of the DP row equals the number of zero bits
+// among bits 0 .. j - 1. Characters of a that do not occur in b leave the
+// vector unchanged and are skipped.
+class LcsBitRow {
+public:
+    LcsBitRow(const char* b, int n) : n_(n), words_((static_cast<std::size_t>(n) + 63) / 64)
+    {
+        std::fill(slot_, slot_ + 256, -1);
+        int used = 0;
+        for (int j = 0; j < n; j++) {
+            unsigned char c = static_cast<unsigned char>(b[j]);
+            if (slot_[c] < 0) {
+                slot_[c] = used++;
+                masks_.resize(static_cast<std::size_t>(used) * words_, 0);
+            }
+            masks_[static_cast<std::size_t>(slot_[c]) * words_ + (j >> 6)] |= std::uint64_t(1) << (j & 63);
+        }
+        v_.assign(words_, ~std::uint64_t(0));
+    }
+
+    void fold(const char* a, int m)
+    {
+        for (int i = 0; i < m; i++) {
+            int s = slot_[static_cast<unsigned char>(a[i])];
+            if (s < 0)
+                continue;
+            const std::uint64_t* mask = &masks_[static_cast<std::size_t>(s) * words_];
+            ALGO_COUNT(cells, n_);
+            unsigned long long carry = 0;
+            for (std::size_t k = 0; k < words_; k++) {
+                unsigned long long v = v_[k], u = v & mask[k], sum;
+                bool c1 = __builtin_uaddll_overflow(v, u, &sum);
+                bool c2 = __builtin_uaddll_overflow(sum, carry, &sum);
+                carry = c1 | c2;
+                v_[k] = sum | (v & ~mask[k]);
+            }
+        }
+    }
+
+    // Padding bits above n stay set, so they never count as matches.
+    int length() const
+    {
+        int zeros = 0;
+        for (std::uint64_t v : v_)
+            zeros += __builtin_popcountll(~v);
+        return zeros;
+    }
+
+    // row[j] = LCS of the folded prefix of a with b[0 .. j), j = 0 .. n
+    void row(int* out) const
+    {
+        int zeros = 0;
+        out[0] = 0;
+        for (int j = 0; j < n_; j++) {
+            zeros += !((v_[j >> 6] >> (j & 63)) & 1);
+            out[j + 1] = zeros;
+        }
+    }
+
+private:
+    int n_;
+    std::size_t words_;
+    int slot_[256];
+    std::vector<std::uint64_t> masks_;
+    std::vector<std::uint64_t> v_;
+};
+
+// Full DP table of (m + 1) x (n + 1) and the original traceback rule.
+inline void lcsTraceback(const std::vector<int>& L, const char* X, const char* Y, int m, int n, std::string& out)
+{
+    const std::size_t stride = static_cast<std::size_t>(n) + 1;
+    auto at = [&](int i, int j) { return L[static_cast<std::size_t>(i) * stride + j]; };
+    std::size_t index = static_cast<std::size_t>(at(m, n));
+    std::size_t base = out.size();
+    out.resize(base + index);
+    int i = m, j = n;
+    while (i > 0 && j > 0) {
+        if (X[i - 1] == Y[j - 1]) {
+            out[base + --index] = X[i - 1];
+            i--;
+            j--;
+        } else if (at(i - 1, j) > at(i, j - 1)) {
+            i--;
+        } else {
+            j--;
+        }
+    }
+}
+
+// Fill rows i0 .. i1 - 1 and columns j0 .. j1 - 1 (both 1-based) of L.
+inline void lcsFillTile(std::vector<int>& L, const char* X, const char* Y, int n, int i0, int i1, int j0, int j1)
+{
+    const std::size_t stride = static_cast<std::size_t>(n) + 1;
+    for (int i = i0; i < i1; i++) {
+        int* cur = &L[static_cast<std::size_t>(i) * stride];
+        const int* prev = cur - stride;
+        const char x = X[i - 1];
+        ALGO_COUNT(cells, j1 - j0);
+        for (int j = j0; j < j1; j++)
+            cur[j] = x == Y[j - 1] ? prev[j - 1] + 1 : std::max(prev[j], cur[j - 1]);
+    }
+}
+
+inline void lcsHirschbergRec(const char* a, int m, const char* b, int n, std::string& out, std::vector<int>& fwd,
+                             std::vector<int>& bwd, std::string& ra, std::string& rb)
+{
+    ALGO_DEPTH_SCOPE();
+    if (m == 0 || n == 0)
+        return;
+    if (m == 1) {
+        if (std::find(b, b + n, a[0]) != b + n)
+            out.push_back(a[0]);
+        return;
+    }
+    if (static_cast<long long>(m) * n <= LCS_TABLE_CUTOFF) {
+        std::vector<int> L((static_cast<std::size_t>(m) + 1) * (n + 1), 0);
+        lcsFillTile(L, a, b, n, 1, m + 1, 1, n + 1);
+        lcsTraceback(L, a, b, m, n, out);
+        return;
+    }
+
+    int mid = m / 2;
+    {
+        LcsBitRow forward(b, n);
+        forward.fold(a, mid);
+        forward.row(fwd.data());
+    }
+    {
+        ra.assign(a + mid, a + m);
+        std::reverse(ra.begin(), ra.end());
+        rb.assign(b, b + n);
+        std::reverse(rb.begin(), rb.end());
+        LcsBitRow backward(rb.data(), n);
+        backward.fold(ra.data(), m - mid);
+        backward.row(bwd.data());
+    }
+    // fwd[k] + bwd[n - k]: best split of b at column k
+    int split = 0, best = -1;
+    for (int k = 0; k <= n; k++) {
+        int total = fwd[k] + bwd[n - k];
+        if (total > best) {
+            best = total;
+            split = k;
+        }
+    }
+    lcsHirschbergRec(a, mid, b, split, out, fwd, bwd, ra, rb);
+    lcsHirschbergRec(a + mid, m - mid, b + split, n - split, out, fwd, bwd, ra, rb);
+}
+
+} // namespace detail
+
+// Length of the LCS of X[0 .. m) and Y[0 .. n). The bits run along the
+// shorter string.
+inline int lcsLength(const char* X, const char* Y, int m, int n)
+{
+    if (m <= 0 || n <= 0)
+        return 0;
+    if (m < n) {
+        std::swap(X, Y);
+        std::swap(m, n);
+    }
+    detail::LcsBitRow row(Y, n);
+    row.fold(X, m);
+    return row.length();
+}
+
+// lcsLength() for sequences of any element types, matched by eq(x[i],
+// y[j]): one rolling DP row along y, O(m n). Character sequences under ==
+// take the bit-parallel path.
+template <class T, class U, class Equal = std::equal_to<>>
+int lcsLength(Span<T> x, Span<U> y, Equal eq = Equal())
+{
+    if constexpr (std::is_same<typename std::remove_cv<T>::type, char>::value &&
+                  std::is_same<typename std::remove_cv<U>::type, char>::value &&
+                  std::is_same<Equal, std::equal_to<>>::value) {
+        return lcsLength(x.data(), y.data(), static_cast<int>(x.size()), static_cast<int>(y.size()));
+    } else {
+        const std::size_t n = y.size();
+        std::vector<int> row(n + 1, 0);
+        for (std::size_t i = 0; i < x.size(); i++) {
+            ALGO_COUNT(cells, n);
+            int diagonal = 0;
+            for (std::size_t j = 1; j <= n; j++) {
+                int above = row[j];
+                row[j] = eq(x[i], y[j - 1]) ? diagonal + 1 : std::max(above, row[j - 1]);
+                diagonal = above;
+            }
+        }
+        return row[n];
+    }
+}
+
+// One longest common subsequence in O(m + n) memory. It has the right
+// length but may differ from the one lcs() traces back when there are ties.
+inline std::string lcsHirschberg(const char* X, const char* Y, int m, int n)
+{
+    std::string out;
+    if (m <= 0 || n <= 0)
+        return out;
+    std::vector<int> fwd(static_cast<std::size_t>(n) + 1), bwd(static_cast<std::size_t>(n) + 1);
+    std::string ra, rb;
+    detail::lcsHirschbergRec(X, m, Y, n, out, fwd, bwd, ra, rb);
+    return out;
+}
+
+// Full-table LCS as in LCS.pdf, with L on the heap. lcs_str, if given,
+// receives the same subsequence the original prints.
+inline int lcs(const char* X, const char* Y, int m, int n, std::string* lcs_str = nullptr)
+{
+    if (lcs_str)
+        lcs_str->clear();
+    if (m <= 0 || n <= 0)
+        return 0;
+    std::vector<int> L((static_cast<std::size_t>(m) + 1) * (n + 1), 0);
+    detail::lcsFillTile(L, X, Y, n, 1, m + 1, 1, n + 1);
+    if (lcs_str)
+        detail::lcsTraceback(L, X, Y, m, n, *lcs_str);
+    return L.back();
+}
+
+// lcs() with the table filled as a wavefront of LCS_TILE x LCS_TILE tiles:
+// every tile on an anti-diagonal only needs the tiles above, to the left
+// and above-left, so a whole diagonal is filled in parallel.
+inline int parallelLcs(const char* X, const char* Y, int m, int n, ThreadPool& pool, std::string* lcs_str = nullptr)
+{
+    if (lcs_str)
+        lcs_str->clear();
+    if (m <= 0 || n <= 0)
+        return 0;
+    std::vector<int> L((static_cast<std::size_t>(m) + 1) * (n + 1), 0);
+    const int rows = (m + LCS_TILE - 1) / LCS_TILE, cols = (n + LCS_TILE - 1) / LCS_TILE;
+    for (int d = 0; d < rows + cols - 1; d++) {
+        int first = std::max(0, d - cols + 1), last = std::min(rows - 1, d);
+        pool.parallelFor(static_cast<std::size_t>(last - first + 1), 1, [&](unsigned, std::size_t b, std::size_t e) {
+            for (std::size_t t = b; t < e; t++) {
+                int ti = first + static_cast<int>(t), tj = d - ti;
+                detail::lcsFillTile(L, X, Y, n, 1 + ti * LCS_TILE, std::min(m, (ti + 1) * LCS_TILE) + 1,
+                                    1 + tj * LCS_TILE, std::min(n, (tj + 1) * LCS_TILE) + 1);
+            }
+        });
+    }
+    if (lcs_str)
+        detail::lcsTraceback(L, X, Y, m, n, *lcs_str);
+    return L.back();
+}
+
+} // namespace algo
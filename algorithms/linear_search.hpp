@@ -0,0 +1,254 @@
+// Linear search of an unsorted int column of any length. The original
+// linearSearch() reads at most int arr[100], and the recursive version
+// uses one stack frame per element. Here the scan is an iterative loop that
+// compares a whole vector of keys per instruction:
+//
+//  - findFirst(): the index of the first match. Four vectors are compared
+//    and OR-ed per step, and the movemask is only decoded when one of them
+//    matched.
+//  - countEqual(): every match. AVX2 subtracts the all-ones compare result
+//    from per-lane counters, AVX-512 popcounts the compare mask.
+//
+// Lengths are size_t and the input is only read, so the column can be a
+// memory-mapped file. The ThreadPool overloads split it into SCAN_GRAIN
+// chunks. findFirst() keeps the lowest match found so far in an atomic, and
+// every chunk that starts after it is skipped, so the scan stops soon after
+// the first match.
+//
+// ScanKernel::Auto picks the widest kernel the CPU supports at runtime.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "simd.hpp"
+#include "thread_pool.hpp"
+
+namespace algo {
+
+enum class ScanKernel { Auto, Scalar, Avx2, Avx512 };
+
+// Keys per parallel chunk, 256 KiB of ints
+const std::size_t SCAN_GRAIN = std::size_t(1) << 16;
+
+inline std::size_t findFirstScalar(const int* arr, std::size_t n, int key)
+{
+    for (std::size_t i = 0; i < n; i++)
+        if (arr[i] == key)
+            return i;
+    return n;
+}
+
+inline std::size_t countEqualScalar(const int* arr, std::size_t n, int key)
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; i++)
+        count += arr[i] == key;
+    return count;
+}
+
+#ifdef ALGO_X86_SIMD
+
+namespace detail {
+
+__attribute__((target("avx2"))) inline __m256i equalAvx2(const int* at, __m256i key)
+{
+    return _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(at)), key);
+}
+
+__attribute__((target("avx2"))) inline unsigned maskAvx2(__m256i eq)
+{
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+}
+
+} // namespace detail
+
+__attribute__((target("avx2"))) inline std::size_t findFirstAvx2(const int* arr, std::size_t n, int key)
+{
+    const __m256i k = _mm256_set1_epi32(key);
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i e0 = detail::equalAvx2(arr + i, k), e1 = detail::equalAvx2(arr + i + 8, k);
+        __m256i e2 = detail::equalAvx2(arr + i + 16, k), e3 = detail::equalAvx2(arr + i + 24, k);
+        __m256i any = _mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3));
+        if (_mm256_testz_si256(any, any))
+            continue;
+        std::uint32_t m = detail::maskAvx2(e0) | detail::maskAvx2(e1) << 8 | detail::maskAvx2(e2) << 16 |
+                          detail::maskAvx2(e3) << 24;
+        return i + __builtin_ctz(m);
+    }
+    for (; i + 8 <= n; i += 8) {
+        unsigned m = detail::maskAvx2(detail::equalAvx2(arr + i, k));
+        if (m)
+            return i + __builtin_ctz(m);
+    }
+    return i + findFirstScalar(arr + i, n - i, key);
+}
+
+__attribute__((target("avx2"))) inline std::size_t countEqualAvx2(const int* arr, std::size_t n, int key)
+{
+    const __m256i k = _mm256_set1_epi32(key);
+    std::size_t count = 0, i = 0;
+    while (i + 32 <= n) {
+        // Lane counters are 32-bit; flush them before they can wrap
+        std::size_t end = i + (std::size_t(1) << 30) < n ? i + (std::size_t(1) << 30) : n;
+        __m256i c0 = _mm256_setzero_si256(), c1 = c0, c2 = c0, c3 = c0;
+        for (; i + 32 <= end; i += 32) {
+            c0 = _mm256_sub_epi32(c0, detail::equalAvx2(arr + i, k));
+            c1 = _mm256_sub_epi32(c1, detail::equalAvx2(arr + i + 8, k));
+            c2 = _mm256_sub_epi32(c2, detail::equalAvx2(arr + i + 16, k));
+            c3 = _mm256_sub_epi32(c3, detail::equalAvx2(arr + i + 24, k));
+        }
+        alignas(32) std::uint32_t lanes[4][8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[0]), c0);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[1]), c1);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[2]), c2);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[3]), c3);
+        for (auto& v : lanes)
+            for (std::uint32_t c : v)
+                count += c;
+    }
+    return count + countEqualScalar(arr + i, n - i, key);
+}
+
+__attribute__((target("avx512f"))) inline std::size_t findFirstAvx512(const int* arr, std::size_t n, int key)
+{
+    const __m512i k = _mm512_set1_epi32(key);
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __mmask16 m0 = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(arr + i), k);
+        __mmask16 m1 = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(arr + i + 16), k);
+        __mmask16 m2 = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(arr + i + 32), k);
+        __mmask16 m3 = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(arr + i + 48), k);
+        if (!(m0 | m1 | m2 | m3))
+            continue;
+        std::uint64_t m = std::uint64_t(m0) | std::uint64_t(m1) << 16 | std::uint64_t(m2) << 32 | std::uint64_t(m3) << 48;
+        return i + __builtin_ctzll(m);
+    }
+    // Masked loads do not touch the lanes past n
+    for (; i < n; i += 16) {
+        __mmask16 valid = n - i >= 16 ? __mmask16(0xFFFF) : static_cast<__mmask16>((1u << (n - i)) - 1);
+        __mmask16 m = _mm512_mask_cmpeq_epi32_mask(valid, _mm512_maskz_loadu_epi32(valid, arr + i), k);
+        if (m)
+            return i + __builtin_ctz(m);
+    }
+    return n;
+}
+
+__attribute__((target("avx512f,popcnt"))) inline std::size_t countEqualAvx512(const int* arr, std::size_t n, int key)
+{
+    const __m512i k = _mm512_set1_epi32(key);
+    std::size_t count = 0, i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __mmask16 m0 = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(arr + i), k);
+        __mmask16 m1 = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(arr + i + 16), k);
+        __mmask16 m2 = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(arr + i + 32), k);
+        __mmask16 m3 = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(arr + i + 48), k);
+        count += __builtin_popcountll(std::uint64_t(m0) | std::uint64_t(m1) << 16 | std::uint64_t(m2) << 32 |
+                                      std::uint64_t(m3) << 48);
+    }
+    for (; i < n; i += 16) {
+        __mmask16 valid = n - i >= 16 ? __mmask16(0xFFFF) : static_cast<__mmask16>((1u << (n - i)) - 1);
+        count += __builtin_popcount(_mm512_mask_cmpeq_epi32_mask(valid, _mm512_maskz_loadu_epi32(valid, arr + i), k));
+    }
+    return count;
+}
+
+#endif // ALGO_X86_SIMD
+
+inline bool scanKernelSupported(ScanKernel kernel)
+{
+    switch (kernel) {
+    case ScanKernel::Auto:
+    case ScanKernel::Scalar:
+        return true;
+#ifdef ALGO_X86_SIMD
+    case ScanKernel::Avx2:
+        return __builtin_cpu_supports("avx2");
+    case ScanKernel::Avx512:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("popcnt");
+#endif
+    default:
+        return false;
+    }
+}
+
+// The kernel Auto resolves to on this CPU.
+inline ScanKernel bestScanKernel()
+{
+    static const ScanKernel best = scanKernelSupported(ScanKernel::Avx512) ? ScanKernel::Avx512
+                                   : scanKernelSupported(ScanKernel::Avx2) ? ScanKernel::Avx2
+                                                                           : ScanKernel::Scalar;
+    return best;
+}
+
+// Index of the first arr[i] == key, n if there is none. Unsupported kernels
+// fall back to Scalar.
+inline std::size_t findFirst(const int* arr, std::size_t n, int key, ScanKernel kernel = ScanKernel::Auto)
+{
+    if (kernel == ScanKernel::Auto)
+        kernel = bestScanKernel();
+#ifdef ALGO_X86_SIMD
+    if (kernel == ScanKernel::Avx512 && scanKernelSupported(kernel))
+        return findFirstAvx512(arr, n, key);
+    if (kernel == ScanKernel::Avx2 && scanKernelSupported(kernel))
+        return findFirstAvx2(arr, n, key);
+#endif
+    return findFirstScalar(arr, n, key);
+}
+
+// Number of arr[i] == key
+inline std::size_t countEqual(const int* arr, std::size_t n, int key, ScanKernel kernel = ScanKernel::Auto)
+{
+    if (kernel == ScanKernel::Auto)
+        kernel = bestScanKernel();
+#ifdef ALGO_X86_SIMD
+    if (kernel == ScanKernel::Avx512 && scanKernelSupported(kernel))
+        return countEqualAvx512(arr, n, key);
+    if (kernel == ScanKernel::Avx2 && scanKernelSupported(kernel))
+        return countEqualAvx2(arr, n, key);
+#endif
+    return countEqualScalar(arr, n, key);
+}
+
+// findFirst() over the pool, skipping chunks past the lowest match so far
+inline std::size_t findFirst(const int* arr, std::size_t n, int key, ThreadPool& pool,
+                             ScanKernel kernel = ScanKernel::Auto)
+{
+    std::atomic<std::size_t> first(n);
+    pool.parallelFor(n, SCAN_GRAIN, [&](unsigned, std::size_t b, std::size_t e) {
+        if (b >= first.load(std::memory_order_relaxed))
+            return;
+        std::size_t at = b + findFirst(arr + b, e - b, key, kernel);
+        if (at == e)
+            return;
+        std::size_t current = first.load(std::memory_order_relaxed);
+        while (at < current && !first.compare_exchange_weak(current, at, std::memory_order_relaxed)) {
+        }
+    });
+    return first.load(std::memory_order_relaxed);
+}
+
+inline std::size_t countEqual(const int* arr, std::size_t n, int key, ThreadPool& pool,
+                              ScanKernel kernel = ScanKernel::Auto)
+{
+    std::vector<std::size_t> perWorker(pool.size(), 0);
+    pool.parallelFor(n, SCAN_GRAIN, [&](unsigned worker, std::size_t b, std::size_t e) {
+        perWorker[worker] += countEqual(arr + b, e - b, key, kernel);
+    });
+    std::size_t total = 0;
+    for (std::size_t c : perWorker)
+        total += c;
+    return total;
+}
+
+// The original contract: 1-based position of the first c, 0 if absent
+inline std::size_t linearSearch(const int arr[], std::size_t n, int c)
+{
+    std::size_t i = findFirst(arr, n, c);
+    return i < n ? i + 1 : 0;
+}
+
+} // namespace algo
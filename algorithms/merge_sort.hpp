@@ -0,0 +1,171 @@
+// Allocation-free merge sort. Instead of malloc'ing L and R in every merge(),
+// the sort works between the array and one scratch buffer of n elements,
+// alternating which of the two each recursion level writes into, so every
+// element is moved exactly once per level. Runs of MERGE_SORT_CUTOFF or
+// fewer elements are insertion sorted. The sort is stable.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "counters.hpp"
+#include "insertion_sort.hpp"
+#include "span.hpp"
+#include "task_pool.hpp"
+
+namespace algo {
+
+const std::size_t MERGE_SORT_CUTOFF = 32;
+
+// Below this many elements parallelMergeSort() runs sequentially, and a
+// half or a merge is one task.
+const std::size_t PARALLEL_MERGE_CUTOFF = 1 << 14;
+
+// Stable merge of a[0..na) and b[0..nb) into out.
+template <class T, class Compare>
+void mergeRuns(const T* a, std::size_t na, const T* b, std::size_t nb, T* out, Compare comp)
+{
+    auto less = countComparisons(comp);
+    ALGO_COUNT(moves, na + nb);
+    std::size_t i = 0, j = 0;
+    while (i < na && j < nb) {
+        if (less(b[j], a[i]))
+            *out++ = b[j++];
+        else
+            *out++ = a[i++];
+    }
+    out = std::copy(a + i, a + na, out);
+    std::copy(b + j, b + nb, out);
+}
+
+namespace detail {
+
+// Sort src[0..n) and leave the result in src (intoOther false) or in
+// other (intoOther true), using the remaining buffer as scratch.
+template <class T, class Compare>
+void mergeSortPingPong(T* src, T* other, std::size_t n, bool intoOther, Compare comp)
+{
+    ALGO_DEPTH_SCOPE();
+    if (n <= MERGE_SORT_CUTOFF) {
+        insertionSort(src, n, comp);
+        if (intoOther) {
+            std::copy(src, src + n, other);
+            ALGO_COUNT(moves, n);
+        }
+        return;
+    }
+    std::size_t mid = n / 2;
+    // Sort both halves into the buffer we are not writing the result to
+    mergeSortPingPong(src, other, mid, !intoOther, comp);
+    mergeSortPingPong(src + mid, other + mid, n - mid, !intoOther, comp);
+    if (intoOther)
+        mergeRuns(src, mid, src + mid, n - mid, other, comp);
+    else
+        mergeRuns(other, mid, other + mid, n - mid, src, comp);
+}
+
+// Number of elements of a that come before out[d] in the stable merge of
+// a and b, found by binary search along the merge path diagonal d.
+template <class T, class Compare>
+std::size_t mergeCoRank(std::size_t d, const T* a, std::size_t na, const T* b, std::size_t nb, Compare comp)
+{
+    std::size_t lo = d > nb ? d - nb : 0, hi = std::min(d, na);
+    while (lo < hi) {
+        std::size_t i = lo + (hi - lo) / 2, j = d - i;
+        if (j > 0 && !comp(b[j - 1], a[i]))
+            lo = i + 1;
+        else
+            hi = i;
+    }
+    return lo;
+}
+
+} // namespace detail
+
+// Sort arr[0..n) using the caller's scratch buffer of at least n elements.
+template <class T, class Compare = std::less<T>>
+void mergeSortWithBuffer(T* arr, std::size_t n, T* scratch, Compare comp = Compare())
+{
+    detail::mergeSortPingPong(arr, scratch, n, false, countComparisons(comp));
+}
+
+// Sort arr[0..n) with a single n-element scratch allocation.
+template <class T, class Compare = std::less<T>>
+void mergeSort(T* arr, std::size_t n, Compare comp = Compare())
+{
+    std::vector<T> scratch(n);
+    mergeSortWithBuffer(arr, n, scratch.data(), comp);
+}
+
+namespace detail {
+
+// mergeRuns() split at the middle of out along the merge path, both halves
+// as tasks
+template <class T, class Compare>
+void mergeRunsTasks(const T* a, std::size_t na, const T* b, std::size_t nb, T* out, TaskPool& pool, Compare comp)
+{
+    const std::size_t total = na + nb;
+    if (total <= PARALLEL_MERGE_CUTOFF) {
+        mergeRuns(a, na, b, nb, out, comp);
+        return;
+    }
+    const std::size_t d = total / 2, i = mergeCoRank(d, a, na, b, nb, comp);
+    pool.invoke([&] { mergeRunsTasks(a, i, b, d - i, out, pool, comp); },
+                [&] { mergeRunsTasks(a + i, na - i, b + (d - i), nb - (d - i), out + d, pool, comp); });
+}
+
+// mergeSortPingPong() with the two halves and the merge as tasks
+template <class T, class Compare>
+void mergeSortTasks(T* src, T* other, std::size_t n, bool intoOther, TaskPool& pool, Compare comp)
+{
+    if (n <= PARALLEL_MERGE_CUTOFF) {
+        mergeSortPingPong(src, other, n, intoOther, comp);
+        return;
+    }
+    std::size_t mid = n / 2;
+    pool.invoke([&] { mergeSortTasks(src, other, mid, !intoOther, pool, comp); },
+                [&] { mergeSortTasks(src + mid, other + mid, n - mid, !intoOther, pool, comp); });
+    if (intoOther)
+        mergeRunsTasks(src, mid, src + mid, n - mid, other, pool, comp);
+    else
+        mergeRunsTasks(other, mid, other + mid, n - mid, src, pool, comp);
+}
+
+} // namespace detail
+
+// Parallel merge sort on a TaskPool: the ping-pong recursion itself, with
+// both halves forked and every merge split along its merge path, so the
+// last merges, which have fewer runs than workers, still run in parallel.
+// It may be called from inside another task of the pool. scratch may be
+// null, or point to at least n elements.
+template <class T, class Compare = std::less<T>>
+void parallelMergeSort(T* arr, std::size_t n, TaskPool& pool, Compare comp = Compare(), T* scratch = nullptr)
+{
+    std::vector<T> owned;
+    if (!scratch) {
+        owned.resize(n);
+        scratch = owned.data();
+    }
+    if (pool.size() == 1 || n <= PARALLEL_MERGE_CUTOFF) {
+        mergeSortWithBuffer(arr, n, scratch, comp);
+        return;
+    }
+    pool.run([&] { detail::mergeSortTasks(arr, scratch, n, false, pool, countComparisons(comp)); });
+}
+
+template <class T, class Compare = std::less<T>>
+void mergeSort(Span<T> s, Compare comp = Compare())
+{
+    mergeSort(s.data(), s.size(), comp);
+}
+
+template <class T, class Compare = std::less<T>>
+void parallelMergeSort(Span<T> s, TaskPool& pool, Compare comp = Compare())
+{
+    parallelMergeSort(s.data(), s.size(), pool, comp);
+}
+
+} // namespace algo
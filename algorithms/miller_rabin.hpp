@@ -0,0 +1,253 @@
+// Deterministic Miller-Rabin for every 64-bit n. The original power_mod()
+// computes (result * base) % mod in long long, which overflows once n
+// passes 2^31, and miller_rabin_test() draws bases from rand(), so answers
+// vary between runs and the call is not thread-safe.
+//
+// Here odd n is first trial-divided by the primes below 64. The
+// survivors are tested with the fixed witnesses 2, 3, .., 37, which decide
+// every n < 3.3 * 10^24, using Montgomery multiplication (two 64 x 64 ->
+// 128-bit multiplies per product, no division). isPrimeBatch() runs
+// MILLER_RABIN_LANES numbers in lockstep so the multiply latency of one
+// chain hides behind the others, and splits the array over a ThreadPool.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+namespace algo {
+
+const std::uint64_t MILLER_RABIN_WITNESSES[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+const std::uint32_t TRIAL_PRIMES[] = {3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61};
+const int MILLER_RABIN_LANES = 4;
+
+// a * b % m without overflow
+inline std::uint64_t mulMod(std::uint64_t a, std::uint64_t b, std::uint64_t m)
+{
+    return static_cast<std::uint64_t>(static_cast<unsigned __int128>(a) * b % m);
+}
+
+// base^exp % mod for any 64-bit mod, the overflow-free power_mod()
+inline std::uint64_t powMod(std::uint64_t base, std::uint64_t exp, std::uint64_t mod)
+{
+    std::uint64_t result = 1 % mod;
+    base %= mod;
+    while (exp > 0) {
+        if (exp & 1)
+            result = mulMod(result, base, mod);
+        exp >>= 1;
+        base = mulMod(base, base, mod);
+    }
+    return result;
+}
+
+// Arithmetic modulo an odd n in Montgomery form, x -> x * 2^64 mod n
+struct Montgomery64 {
+    std::uint64_t n, inv, r2, one;
+
+    explicit Montgomery64(std::uint64_t odd) : n(odd)
+    {
+        inv = n; // Newton iteration, each step doubles the correct low bits
+        for (int i = 0; i < 5; i++)
+            inv *= 2 - n * inv;
+        one = (0 - n) % n; // 2^64 mod n
+        r2 = mulMod(one, one, n);
+    }
+
+    // T * 2^-64 mod n for T < n * 2^64
+    std::uint64_t reduce(unsigned __int128 t) const
+    {
+        std::uint64_t m = static_cast<std::uint64_t>(t) * inv;
+        std::uint64_t hi = static_cast<std::uint64_t>(t >> 64);
+        std::uint64_t mn = static_cast<std::uint64_t>((static_cast<unsigned __int128>(m) * n) >> 64);
+        return hi >= mn ? hi - mn : hi - mn + n;
+    }
+
+    std::uint64_t mul(std::uint64_t a, std::uint64_t b) const
+    {
+        return reduce(static_cast<unsigned __int128>(a) * b);
+    }
+    std::uint64_t to(std::uint64_t a) const { return mul(a % n, r2); }
+};
+
+namespace detail {
+
+// 0 composite, 1 prime, -1 undecided (odd, no factor below 64, n >= 67^2)
+inline int primeByTrialDivision(std::uint64_t n)
+{
+    if (n < 2)
+        return 0;
+    if (n % 2 == 0)
+        return n == 2;
+    for (std::uint32_t p : TRIAL_PRIMES) {
+        if (n % p == 0)
+            return n == p;
+    }
+    return n < 67 * 67 ? 1 : -1;
+}
+
+// One strong-probable-prime round to base a; n - 1 = d * 2^s, d odd
+inline bool strongProbablePrime(const Montgomery64& mont, std::uint64_t d, int s, std::uint64_t a)
+{
+    const std::uint64_t minusOne = mont.n - mont.one;
+    std::uint64_t x = mont.one, b = mont.to(a);
+    for (std::uint64_t e = d; e; e >>= 1) {
+        if (e & 1)
+            x = mont.mul(x, b);
+        b = mont.mul(b, b);
+    }
+    if (x == mont.one || x == minusOne)
+        return true;
+    for (int r = 1; r < s; r++) {
+        x = mont.mul(x, x);
+        if (x == minusOne)
+            return true;
+    }
+    return false;
+}
+
+inline bool millerRabin(std::uint64_t n)
+{
+    const Montgomery64 mont(n);
+    int s = __builtin_ctzll(n - 1);
+    std::uint64_t d = (n - 1) >> s;
+    for (std::uint64_t a : MILLER_RABIN_WITNESSES)
+        if (!strongProbablePrime(mont, d, s, a))
+            return false;
+    return true;
+}
+
+// The witnesses after the first on MILLER_RABIN_LANES numbers at once.
+// Each lane runs the same square-and-multiply steps on its own chain, a
+// lane with a shorter exponent just squares its leading one, and the
+// multiply is a select.
+inline void millerRabinLanes(const std::uint64_t* n, bool* prime)
+{
+    const int L = MILLER_RABIN_LANES;
+    std::uint64_t d[L], one[L], minusOne[L], nn[L], inv[L], r2[L];
+    int s[L], maxS = 0, bits = 0;
+    for (int l = 0; l < L; l++) {
+        Montgomery64 m(n[l]);
+        nn[l] = m.n;
+        inv[l] = m.inv;
+        r2[l] = m.r2;
+        one[l] = m.one;
+        minusOne[l] = n[l] - m.one;
+        s[l] = __builtin_ctzll(n[l] - 1);
+        d[l] = (n[l] - 1) >> s[l];
+        maxS = s[l] > maxS ? s[l] : maxS;
+        int b = 64 - __builtin_clzll(d[l]);
+        bits = b > bits ? b : bits;
+        prime[l] = true;
+    }
+    auto mul = [&](int l, std::uint64_t a, std::uint64_t b) {
+        unsigned __int128 t = static_cast<unsigned __int128>(a) * b;
+        std::uint64_t m = static_cast<std::uint64_t>(t) * inv[l];
+        std::uint64_t hi = static_cast<std::uint64_t>(t >> 64);
+        std::uint64_t mn = static_cast<std::uint64_t>((static_cast<unsigned __int128>(m) * nn[l]) >> 64);
+        return hi >= mn ? hi - mn : hi - mn + nn[l];
+    };
+
+    for (std::size_t w = 1; w < sizeof(MILLER_RABIN_WITNESSES) / sizeof(MILLER_RABIN_WITNESSES[0]); w++) {
+        const std::uint64_t a = MILLER_RABIN_WITNESSES[w];
+        std::uint64_t x[L], base[L];
+        bool done[L];
+        for (int l = 0; l < L; l++) {
+            x[l] = one[l];
+            base[l] = mul(l, a % nn[l], r2[l]);
+        }
+        for (int bit = bits - 1; bit >= 0; bit--) {
+            for (int l = 0; l < L; l++) {
+                std::uint64_t sq = mul(l, x[l], x[l]);
+                std::uint64_t prod = mul(l, sq, base[l]);
+                x[l] = (d[l] >> bit) & 1 ? prod : sq;
+            }
+        }
+        int undecided = 0;
+        for (int l = 0; l < L; l++) {
+            done[l] = !prime[l] || x[l] == one[l] || x[l] == minusOne[l];
+            undecided += !done[l];
+        }
+        for (int r = 1; r < maxS && undecided; r++) {
+            for (int l = 0; l < L; l++) {
+                if (done[l] || r >= s[l])
+                    continue;
+                x[l] = mul(l, x[l], x[l]);
+                if (x[l] == minusOne[l]) {
+                    done[l] = true;
+                    undecided--;
+                }
+            }
+        }
+        bool any = false;
+        for (int l = 0; l < L; l++) {
+            if (!done[l])
+                prime[l] = false;
+            any = any || prime[l];
+        }
+        if (!any)
+            return;
+    }
+}
+
+inline void isPrimeRange(const std::uint64_t* numbers, std::size_t begin, std::size_t end, std::uint8_t* out)
+{
+    std::uint64_t lane[MILLER_RABIN_LANES];
+    std::size_t index[MILLER_RABIN_LANES];
+    bool prime[MILLER_RABIN_LANES];
+    int filled = 0;
+    for (std::size_t i = begin; i < end; i++) {
+        int trial = primeByTrialDivision(numbers[i]);
+        if (trial >= 0) {
+            out[i] = static_cast<std::uint8_t>(trial);
+            continue;
+        }
+        // Base 2 alone rejects nearly every composite; only its survivors,
+        // mostly primes, need the lockstep rounds.
+        const std::uint64_t n = numbers[i];
+        int s = __builtin_ctzll(n - 1);
+        if (!strongProbablePrime(Montgomery64(n), (n - 1) >> s, s, MILLER_RABIN_WITNESSES[0])) {
+            out[i] = 0;
+            continue;
+        }
+        lane[filled] = numbers[i];
+        index[filled++] = i;
+        if (filled == MILLER_RABIN_LANES) {
+            millerRabinLanes(lane, prime);
+            for (int l = 0; l < MILLER_RABIN_LANES; l++)
+                out[index[l]] = prime[l];
+            filled = 0;
+        }
+    }
+    for (int l = filled; l < MILLER_RABIN_LANES; l++)
+        lane[l] = lane[0];
+    if (filled) {
+        millerRabinLanes(lane, prime);
+        for (int l = 0; l < filled; l++)
+            out[index[l]] = prime[l];
+    }
+}
+
+} // namespace detail
+
+// Deterministic primality test for every 64-bit n
+inline bool isPrime(std::uint64_t n)
+{
+    int trial = detail::primeByTrialDivision(n);
+    return trial >= 0 ? trial == 1 : detail::millerRabin(n);
+}
+
+// out[i] = isPrime(numbers[i]); split over pool when given
+inline void isPrimeBatch(const std::uint64_t* numbers, std::size_t count, std::uint8_t* out,
+                         ThreadPool* pool = nullptr)
+{
+    if (!pool) {
+        detail::isPrimeRange(numbers, 0, count, out);
+        return;
+    }
+    pool->parallelFor(count, 0, [&](unsigned, std::size_t b, std::size_t e) { detail::isPrimeRange(numbers, b, e, out); });
+}
+
+} // namespace algo
@@ -0,0 +1,145 @@
+// Parallel Borůvka minimum spanning tree on a ThreadPool.
+// Each round every live edge offers itself to the components at both ends
+// with an atomic fetch-min, the winners are linked through a lock-free
+// union-find, and edges inside one component are filtered out. Ties are
+// broken by (weight, edge index), the same total order kruskal() uses, so
+// the MST is unique and the result is identical to kruskal(): same edges,
+// same order, same mincost.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "graph.hpp"
+#include "kruskal.hpp"
+#include "thread_pool.hpp"
+
+namespace algo {
+
+// Union-find safe for concurrent find() and uni(). Roots are always linked
+// under the smaller index, so concurrent links can never form a cycle.
+class ConcurrentDisjointSet {
+public:
+    explicit ConcurrentDisjointSet(int n) : parent_(n)
+    {
+        for (int i = 0; i < n; i++)
+            parent_[i].store(i, std::memory_order_relaxed);
+    }
+
+    int find(int i)
+    {
+        for (;;) {
+            int p = parent_[i].load(std::memory_order_relaxed);
+            if (p == i)
+                return i;
+            int gp = parent_[p].load(std::memory_order_relaxed);
+            if (gp != p) // path halving; losing the race is harmless
+                parent_[i].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+            i = gp;
+        }
+    }
+
+    bool uni(int i, int j)
+    {
+        for (;;) {
+            i = find(i);
+            j = find(j);
+            if (i == j)
+                return false;
+            if (i < j)
+                std::swap(i, j);
+            int expected = i;
+            if (parent_[i].compare_exchange_strong(expected, j, std::memory_order_acq_rel))
+                return true;
+        }
+    }
+
+private:
+    std::vector<std::atomic<int>> parent_;
+};
+
+inline MstResult boruvka(int n, const std::vector<Edge>& edges, ThreadPool& pool)
+{
+    const std::uint64_t NONE = ~0ull;
+    auto rank = [&](std::uint32_t e) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(edges[e].w) ^ 0x80000000u) << 32) | e;
+    };
+
+    std::vector<std::uint32_t> live(edges.size());
+    for (std::size_t e = 0; e < edges.size(); e++)
+        live[e] = static_cast<std::uint32_t>(e);
+
+    ConcurrentDisjointSet sets(n);
+    std::vector<std::atomic<std::uint64_t>> best(n);
+    std::vector<std::atomic<bool>> taken(edges.size());
+    for (std::size_t e = 0; e < edges.size(); e++)
+        taken[e].store(false, std::memory_order_relaxed);
+    std::vector<std::vector<std::uint32_t>> kept(pool.size()), added(pool.size());
+
+    auto offer = [&](int c, std::uint64_t key) {
+        std::uint64_t cur = best[c].load(std::memory_order_relaxed);
+        while (key < cur && !best[c].compare_exchange_weak(cur, key, std::memory_order_relaxed)) {
+        }
+    };
+
+    while (!live.empty()) {
+        pool.parallelFor(n, 0, [&](unsigned, std::size_t b, std::size_t e) {
+            for (std::size_t c = b; c < e; c++)
+                best[c].store(NONE, std::memory_order_relaxed);
+        });
+
+        // Lightest outgoing edge of every component; drop internal edges
+        pool.parallelFor(live.size(), 0, [&](unsigned worker, std::size_t b, std::size_t e) {
+            for (std::size_t k = b; k < e; k++) {
+                std::uint32_t x = live[k];
+                int cu = sets.find(edges[x].u), cv = sets.find(edges[x].v);
+                if (cu == cv)
+                    continue;
+                kept[worker].push_back(x);
+                offer(cu, rank(x));
+                offer(cv, rank(x));
+            }
+        });
+
+        live.clear();
+        for (std::vector<std::uint32_t>& part : kept) {
+            live.insert(live.end(), part.begin(), part.end());
+            part.clear();
+        }
+        if (live.empty())
+            break;
+
+        // Link along the chosen edges; both endpoints may pick the same one
+        pool.parallelFor(n, 0, [&](unsigned worker, std::size_t b, std::size_t e) {
+            for (std::size_t c = b; c < e; c++) {
+                std::uint64_t key = best[c].load(std::memory_order_relaxed);
+                if (key == NONE)
+                    continue;
+                std::uint32_t x = static_cast<std::uint32_t>(key);
+                if (taken[x].exchange(true, std::memory_order_relaxed))
+                    continue;
+                sets.uni(edges[x].u, edges[x].v);
+                added[worker].push_back(x);
+            }
+        });
+    }
+
+    std::vector<std::uint64_t> chosen;
+    for (std::vector<std::uint32_t>& part : added)
+        for (std::uint32_t x : part)
+            chosen.push_back(rank(x));
+    std::sort(chosen.begin(), chosen.end());
+
+    MstResult result;
+    result.edges.reserve(chosen.size());
+    for (std::uint64_t key : chosen) {
+        const Edge& e = edges[static_cast<std::uint32_t>(key)];
+        result.edges.push_back(e);
+        result.mincost += e.w;
+    }
+    return result;
+}
+
+} // namespace algo
@@ -0,0 +1,195 @@
+// N-Queens on bitboards for a runtime N (up to 32). The original fixes
+// #define N 8, keeps int board[N][N], and isSafe() rescans the row and
+// both diagonals for every placement. Here the occupied rows and the two
+// diagonal directions of the columns placed so far are three masks. The
+// free rows of the next column are ~(rows | up | down), visited lowest bit
+// first.
+//
+// Queens are placed column by column and rows are tried from 0 upward, as
+// in solveNQUtil(), so nQueensFirst() returns the board the original
+// prints. NQueens<N> is the same search for a board size fixed at compile
+// time. On a TaskPool every free row of the columns before
+// NQUEENS_TASK_DEPTH is a task of its own.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "task_pool.hpp"
+
+namespace algo {
+
+const int NQUEENS_MAX = 32;
+
+// Columns before this one fork a task per free row on a TaskPool; from it
+// on a task searches sequentially
+const int NQUEENS_TASK_DEPTH = 3;
+
+namespace detail {
+
+struct QueensPrefix {
+    std::uint32_t rows, up, down;
+    long long weight; // symmetric copies this prefix stands for
+};
+
+inline long long nQueensCountFrom(std::uint32_t all, std::uint32_t rows, std::uint32_t up, std::uint32_t down)
+{
+    if (rows == all)
+        return 1;
+    long long count = 0;
+    std::uint32_t free = all & ~(rows | up | down);
+    while (free) {
+        std::uint32_t bit = free & (0u - free);
+        free ^= bit;
+        count += nQueensCountFrom(all, rows | bit, (up | bit) << 1, (down | bit) >> 1);
+    }
+    return count;
+}
+
+inline bool nQueensFirstFrom(std::uint32_t all, std::uint32_t rows, std::uint32_t up, std::uint32_t down, int col,
+                             int* rowOf)
+{
+    if (rows == all)
+        return true;
+    std::uint32_t free = all & ~(rows | up | down);
+    while (free) {
+        std::uint32_t bit = free & (0u - free);
+        free ^= bit;
+        rowOf[col] = __builtin_ctz(bit);
+        if (nQueensFirstFrom(all, rows | bit, (up | bit) << 1, (down | bit) >> 1, col + 1, rowOf))
+            return true;
+    }
+    return false;
+}
+
+constexpr std::uint32_t queensMask(int N) { return N == 32 ? ~0u : (1u << N) - 1; }
+
+// The first two columns, up to mirror symmetry. A board and its mirror
+// image (row r -> N - 1 - r) are distinct solutions, so only first-column
+// rows in the lower half are expanded, with weight 2. For odd N the middle
+// row is its own mirror; it is expanded with the second column restricted
+// to the lower half instead.
+inline std::vector<QueensPrefix> nQueensPrefixes(int N)
+{
+    const std::uint32_t all = queensMask(N);
+    std::vector<QueensPrefix> prefixes;
+    auto second = [&](std::uint32_t bit, std::uint32_t allowed, long long weight) {
+        std::uint32_t rows = bit, up = bit << 1, down = bit >> 1;
+        std::uint32_t free = allowed & ~(rows | up | down);
+        while (free) {
+            std::uint32_t b = free & (0u - free);
+            free ^= b;
+            prefixes.push_back({rows | b, (up | b) << 1, (down | b) >> 1, weight});
+        }
+    };
+    for (int r = 0; r < N / 2; r++)
+        second(1u << r, all, 2);
+    if (N % 2)
+        second(1u << (N / 2), (1u << (N / 2)) - 1, 2);
+    return prefixes;
+}
+
+// nQueensCountFrom() for a board with col columns placed
+inline long long nQueensCountTasks(TaskPool& pool, std::uint32_t all, std::uint32_t rows, std::uint32_t up,
+                                   std::uint32_t down, int col)
+{
+    if (col >= NQUEENS_TASK_DEPTH || rows == all)
+        return nQueensCountFrom(all, rows, up, down);
+    std::uint32_t bits[NQUEENS_MAX];
+    long long counts[NQUEENS_MAX];
+    int k = 0;
+    for (std::uint32_t free = all & ~(rows | up | down); free; free &= free - 1)
+        bits[k++] = free & (0u - free);
+    pool.parallelFor(k, 1, [&](unsigned, std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; i++)
+            counts[i] = nQueensCountTasks(pool, all, rows | bits[i], (up | bits[i]) << 1, (down | bits[i]) >> 1,
+                                          col + 1);
+    });
+    long long count = 0;
+    for (int i = 0; i < k; i++)
+        count += counts[i];
+    return count;
+}
+
+} // namespace detail
+
+// Number of solutions for an N x N board (0 outside 1 .. NQUEENS_MAX).
+inline long long nQueensCount(int N)
+{
+    if (N < 1 || N > NQUEENS_MAX)
+        return 0;
+    return detail::nQueensCountFrom(detail::queensMask(N), 0, 0, 0);
+}
+
+// nQueensCount() on a TaskPool, about half the search thanks to the mirror
+// symmetry: the first two columns up to symmetry, and below them each row
+// of the columns before NQUEENS_TASK_DEPTH, are tasks. It may be called
+// from inside another task.
+inline long long nQueensCount(int N, TaskPool& pool)
+{
+    if (N < 1 || N > NQUEENS_MAX)
+        return 0;
+    if (N < 4 || pool.size() == 1)
+        return nQueensCount(N);
+    const std::uint32_t all = detail::queensMask(N);
+    std::vector<detail::QueensPrefix> prefixes = detail::nQueensPrefixes(N);
+    std::vector<long long> counts(prefixes.size());
+    pool.parallelFor(prefixes.size(), 1, [&](unsigned, std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; i++) {
+            const detail::QueensPrefix& p = prefixes[i];
+            counts[i] = p.weight * detail::nQueensCountTasks(pool, all, p.rows, p.up, p.down, 2);
+        }
+    });
+    long long total = 0;
+    for (long long c : counts)
+        total += c;
+    return total;
+}
+
+// First solution in the original's search order: rowOf[col] is the row of
+// the queen in column col. Returns false if there is none.
+inline bool nQueensFirst(int N, std::vector<int>& rowOf)
+{
+    rowOf.assign(N > 0 ? N : 0, -1);
+    if (N < 1 || N > NQUEENS_MAX)
+        return false;
+    return detail::nQueensFirstFrom(detail::queensMask(N), 0, 0, 0, 0, rowOf.data());
+}
+
+// N fixed at compile time: the board mask is a constant the search is
+// specialised for, and count() is constexpr, so NQueens<8>::count() can be
+// a constant expression.
+template <int N>
+class NQueens {
+public:
+    static_assert(N >= 1 && N <= NQUEENS_MAX, "N-Queens boards are 1 to 32 wide");
+    static constexpr std::uint32_t ALL = detail::queensMask(N);
+
+    static constexpr long long count() { return countFrom(0, 0, 0); }
+
+    // nQueensFirst() on this board
+    static bool first(std::array<int, N>& rowOf)
+    {
+        rowOf.fill(-1);
+        return detail::nQueensFirstFrom(ALL, 0, 0, 0, 0, rowOf.data());
+    }
+
+private:
+    static constexpr long long countFrom(std::uint32_t rows, std::uint32_t up, std::uint32_t down)
+    {
+        if (rows == ALL)
+            return 1;
+        long long count = 0;
+        std::uint32_t free = ALL & ~(rows | up | down);
+        while (free) {
+            std::uint32_t bit = free & (0u - free);
+            free ^= bit;
+            count += countFrom(rows | bit, (up | bit) << 1, (down | bit) >> 1);
+        }
+        return count;
+    }
+};
+
+} // namespace algo
@@ -0,0 +1,255 @@
+// Partition kernels for int keys, used by quickSortInt().
+// Every kernel moves the elements of arr[0..n) that are < pivot to the front
+// and returns how many there are; the order within each side is unspecified.
+//
+//  - Scalar: the branchy Lomuto loop of the original partition(), kept as
+//    the reference implementation.
+//  - Block: BlockQuicksort (Edelkamp & Weiß). Misplaced elements are found
+//    in blocks of 64 by writing offsets branch-free, then swapped in bulk.
+//  - Avx2 / Avx512: in-place vectorised partition. Each vector of keys is
+//    compared against the pivot in one instruction and written to both ends
+//    of the free gap (permutation table on AVX2, compress stores on AVX-512).
+//
+// PartitionKernel::Auto picks the widest kernel the CPU supports at runtime.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "simd.hpp"
+
+namespace algo {
+
+enum class PartitionKernel { Auto, Scalar, Block, Avx2, Avx512 };
+
+inline std::size_t partitionScalar(int* arr, std::size_t n, int pivot)
+{
+    std::size_t i = 0;
+    for (std::size_t j = 0; j < n; j++) {
+        if (arr[j] < pivot)
+            std::swap(arr[i++], arr[j]);
+    }
+    return i;
+}
+
+inline std::size_t partitionBlock(int* arr, std::size_t n, int pivot)
+{
+    const std::size_t BLOCK = 64;
+    unsigned char offsetsL[BLOCK], offsetsR[BLOCK];
+    std::size_t l = 0, r = n;
+    std::size_t numL = 0, numR = 0, startL = 0, startR = 0;
+
+    while (r - l > 2 * BLOCK) {
+        // Offsets of elements in the left block that belong on the right,
+        // and of elements in the right block that belong on the left
+        if (numL == 0) {
+            startL = 0;
+            for (std::size_t i = 0; i < BLOCK; i++) {
+                offsetsL[numL] = static_cast<unsigned char>(i);
+                numL += !(arr[l + i] < pivot);
+            }
+        }
+        if (numR == 0) {
+            startR = 0;
+            for (std::size_t i = 0; i < BLOCK; i++) {
+                offsetsR[numR] = static_cast<unsigned char>(i);
+                numR += arr[r - 1 - i] < pivot;
+            }
+        }
+
+        std::size_t num = numL < numR ? numL : numR;
+        for (std::size_t j = 0; j < num; j++)
+            std::swap(arr[l + offsetsL[startL + j]], arr[r - 1 - offsetsR[startR + j]]);
+
+        numL -= num;
+        numR -= num;
+        startL += num;
+        startR += num;
+        if (numL == 0)
+            l += BLOCK;
+        if (numR == 0)
+            r -= BLOCK;
+    }
+
+    // Everything left of l is < pivot and everything from r on is not;
+    // the unfinished middle is small enough for the scalar loop
+    return l + partitionScalar(arr + l, r - l, pivot);
+}
+
+#ifdef ALGO_X86_SIMD
+
+namespace detail {
+
+// Scatter the last few keys once the vector loop has filled the gap.
+inline std::size_t partitionFinish(int* arr, std::size_t writeL, std::size_t writeR, const int* rest,
+                                   std::size_t count, int pivot)
+{
+    for (std::size_t i = 0; i < count; i++) {
+        if (rest[i] < pivot)
+            arr[writeL++] = rest[i];
+        else
+            arr[--writeR] = rest[i];
+    }
+    return writeL;
+}
+
+// permutations[m] moves the lanes whose bit is set in m to the front,
+// keeping the others after them.
+struct Avx2PartitionTable {
+    alignas(32) std::int32_t permutations[256][8];
+
+    Avx2PartitionTable()
+    {
+        for (int m = 0; m < 256; m++) {
+            int k = 0;
+            for (int lane = 0; lane < 8; lane++)
+                if (m & (1 << lane))
+                    permutations[m][k++] = lane;
+            for (int lane = 0; lane < 8; lane++)
+                if (!(m & (1 << lane)))
+                    permutations[m][k++] = lane;
+        }
+    }
+};
+
+inline const Avx2PartitionTable& avx2PartitionTable()
+{
+    static const Avx2PartitionTable table;
+    return table;
+}
+
+} // namespace detail
+
+__attribute__((target("avx2,popcnt"))) inline std::size_t partitionAvx2(int* arr, std::size_t n, int pivot)
+{
+    const std::size_t W = 8;
+    if (n < 2 * W + W)
+        return partitionScalar(arr, n, pivot);
+
+    const auto& table = detail::avx2PartitionTable();
+    const __m256i p = _mm256_set1_epi32(pivot);
+
+    // Holding one vector from each end opens a gap of W at both ends
+    alignas(32) int saved[4 * W];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(saved), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(arr)));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(saved + W),
+                       _mm256_loadu_si256(reinterpret_cast<const __m256i*>(arr + n - W)));
+
+    std::size_t readL = W, readR = n - W, writeL = 0, writeR = n;
+    while (readR - readL >= W) {
+        __m256i v;
+        // Read from the side with the smaller gap so both stay >= W wide
+        if (readL - writeL <= writeR - readR) {
+            v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(arr + readL));
+            readL += W;
+        } else {
+            readR -= W;
+            v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(arr + readR));
+        }
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(p, v))));
+        std::size_t less = static_cast<std::size_t>(__builtin_popcount(mask));
+        __m256i perm = _mm256_load_si256(reinterpret_cast<const __m256i*>(table.permutations[mask]));
+        __m256i packed = _mm256_permutevar8x32_epi32(v, perm);
+        // Smaller keys land at writeL, the rest at the top of writeR
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(arr + writeL), packed);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(arr + writeR - W), packed);
+        writeL += less;
+        writeR -= W - less;
+    }
+
+    std::size_t rest = readR - readL;
+    for (std::size_t i = 0; i < rest; i++)
+        saved[2 * W + i] = arr[readL + i];
+    return detail::partitionFinish(arr, writeL, writeR, saved, 2 * W + rest, pivot);
+}
+
+__attribute__((target("avx512f,popcnt"))) inline std::size_t partitionAvx512(int* arr, std::size_t n, int pivot)
+{
+    const std::size_t W = 16;
+    if (n < 2 * W + W)
+        return partitionScalar(arr, n, pivot);
+
+    const __m512i p = _mm512_set1_epi32(pivot);
+    alignas(64) int saved[4 * W];
+    _mm512_store_si512(saved, _mm512_loadu_si512(arr));
+    _mm512_store_si512(saved + W, _mm512_loadu_si512(arr + n - W));
+
+    std::size_t readL = W, readR = n - W, writeL = 0, writeR = n;
+    while (readR - readL >= W) {
+        __m512i v;
+        if (readL - writeL <= writeR - readR) {
+            v = _mm512_loadu_si512(arr + readL);
+            readL += W;
+        } else {
+            readR -= W;
+            v = _mm512_loadu_si512(arr + readR);
+        }
+        __mmask16 lessMask = _mm512_cmplt_epi32_mask(v, p);
+        std::size_t less = static_cast<std::size_t>(__builtin_popcount(lessMask));
+        _mm512_mask_compressstoreu_epi32(arr + writeL, lessMask, v);
+        _mm512_mask_compressstoreu_epi32(arr + writeR - (W - less), static_cast<__mmask16>(~lessMask), v);
+        writeL += less;
+        writeR -= W - less;
+    }
+
+    std::size_t rest = readR - readL;
+    for (std::size_t i = 0; i < rest; i++)
+        saved[2 * W + i] = arr[readL + i];
+    return detail::partitionFinish(arr, writeL, writeR, saved, 2 * W + rest, pivot);
+}
+
+#endif // ALGO_X86_SIMD
+
+inline bool partitionKernelSupported(PartitionKernel kernel)
+{
+    switch (kernel) {
+    case PartitionKernel::Auto:
+    case PartitionKernel::Scalar:
+    case PartitionKernel::Block:
+        return true;
+#ifdef ALGO_X86_SIMD
+    case PartitionKernel::Avx2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+    case PartitionKernel::Avx512:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("popcnt");
+#endif
+    default:
+        return false;
+    }
+}
+
+// The kernel Auto resolves to on this CPU.
+inline PartitionKernel bestPartitionKernel()
+{
+    static const PartitionKernel best = partitionKernelSupported(PartitionKernel::Avx512) ? PartitionKernel::Avx512
+                                        : partitionKernelSupported(PartitionKernel::Avx2) ? PartitionKernel::Avx2
+                                                                                          : PartitionKernel::Block;
+    return best;
+}
+
+// Unsupported kernels fall back to Block.
+inline std::size_t partitionLess(int* arr, std::size_t n, int pivot, PartitionKernel kernel = PartitionKernel::Auto)
+{
+    if (kernel == PartitionKernel::Auto)
+        kernel = bestPartitionKernel();
+    switch (kernel) {
+    case PartitionKernel::Scalar:
+        return partitionScalar(arr, n, pivot);
+#ifdef ALGO_X86_SIMD
+    case PartitionKernel::Avx2:
+        if (partitionKernelSupported(kernel))
+            return partitionAvx2(arr, n, pivot);
+        break;
+    case PartitionKernel::Avx512:
+        if (partitionKernelSupported(kernel))
+            return partitionAvx512(arr, n, pivot);
+        break;
+#endif
+    default:
+        break;
+    }
+    return partitionBlock(arr, n, pivot);
+}
+
+} // namespace algo
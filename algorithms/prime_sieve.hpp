@@ -0,0 +1,406 @@
+// Segmented sieve of Eratosthenes for "which numbers in [a, b] are prime",
+// plus a cache of sieved ranges behind is_prime().
+//
+// Only odd numbers are stored, one bit each; bit i of a range is
+// base + 2i + 1. The range is sieved in SIEVE_SEGMENT_BYTES pieces that
+// stay in L1. Each piece starts as a copy of a precomputed wheel pattern
+// with the multiples of 3, 5, 7, 11 and 13 already removed, so only primes
+// from 17 up are crossed off one by one. Each worker sieves one run of
+// consecutive segments, word ranges of the result, without copying.
+//
+// The base primes up to sqrt(hi) come from the same sieve, in blocks of
+// SIEVE_BASE_BLOCK numbers. Primes below the segment length keep their next
+// multiple across segments; larger ones hit a segment at most once and wait
+// in the bucket of the segment holding their next multiple, so a segment
+// only visits the primes that cross it off. A range much shorter than
+// sqrt(hi), where the base primes would cost more than the range itself, is
+// tested with Miller-Rabin instead.
+//
+// PrimeCache keeps every sieved range. A query inside one is a bit test;
+// anything else falls back to the deterministic Miller-Rabin.
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include "miller_rabin.hpp"
+#include "thread_pool.hpp"
+
+namespace algo {
+
+const std::size_t SIEVE_SEGMENT_BYTES = 32 * 1024;
+// Sieved ranges must end below this so p * p and the multiples stay exact.
+const std::uint64_t SIEVE_LIMIT = std::uint64_t(1) << 62;
+// Base primes up to this come from a plain byte sieve
+const std::uint32_t SIEVE_PLAIN_MAX = 1 << 16;
+// Numbers per block when the base primes are sieved
+const std::uint64_t SIEVE_BASE_BLOCK = std::uint64_t(1) << 26;
+// Ranges shorter than sqrt(hi) / SIEVE_MILLER_RABIN_RATIO are tested with
+// Miller-Rabin
+const std::uint64_t SIEVE_MILLER_RABIN_RATIO = 64;
+
+namespace detail {
+
+const std::uint32_t WHEEL_PRIMES[] = {3, 5, 7, 11, 13};
+// The pattern of odd numbers repeats every 3 * 5 * 7 * 11 * 13 bits; as
+// many 64-bit words keeps a word-aligned copy possible from any offset.
+const std::size_t WHEEL_WORDS = 3 * 5 * 7 * 11 * 13;
+
+// Bit i set when 2i + 1 has no factor in WHEEL_PRIMES
+inline const std::vector<std::uint64_t>& wheelPattern()
+{
+    static const std::vector<std::uint64_t> pattern = [] {
+        std::vector<std::uint64_t> bits(WHEEL_WORDS, ~std::uint64_t(0));
+        for (std::uint32_t p : WHEEL_PRIMES)
+            for (std::size_t i = p / 2; i < WHEEL_WORDS * 64; i += p) // 2i + 1 = p, 3p, 5p, ..
+                bits[i >> 6] &= ~(std::uint64_t(1) << (i & 63));
+        return bits;
+    }();
+    return pattern;
+}
+
+// Odd primes up to limit, at most SIEVE_PLAIN_MAX, with a plain odd-only
+// sieve
+inline std::vector<std::uint32_t> smallPrimes(std::uint32_t limit)
+{
+    std::vector<std::uint32_t> primes;
+    if (limit < 3)
+        return primes;
+    std::vector<std::uint8_t> composite(limit / 2 + 1, 0);
+    for (std::uint32_t i = 1; 2 * i + 1 <= limit; i++) {
+        if (composite[i])
+            continue;
+        std::uint32_t p = 2 * i + 1;
+        primes.push_back(p);
+        for (std::uint64_t m = std::uint64_t(p) * p; m <= limit; m += 2 * p)
+            composite[m / 2] = 1;
+    }
+    return primes;
+}
+
+inline std::uint64_t isqrt(std::uint64_t n)
+{
+    std::uint64_t r = static_cast<std::uint64_t>(std::sqrt(static_cast<double>(n)));
+    while (r * r > n)
+        r--;
+    while ((r + 1) * (r + 1) <= n)
+        r++;
+    return r;
+}
+
+} // namespace detail
+
+// The primes of [lo, hi]
+class SievedRange {
+public:
+    SievedRange() = default;
+
+    // Sieve [lo, hi], hi < SIEVE_LIMIT; pool splits the segments.
+    SievedRange(std::uint64_t lo, std::uint64_t hi, ThreadPool* pool = nullptr) : lo_(lo), hi_(hi)
+    {
+        if (hi_ >= SIEVE_LIMIT)
+            hi_ = SIEVE_LIMIT - 1;
+        if (lo_ > hi_)
+            return;
+        // Words line up with the wheel pattern: bit 0 is base_ + 1, base_
+        // a multiple of 128
+        base_ = lo_ / 128 * 128;
+        std::size_t bits = static_cast<std::size_t>((hi_ - base_) / 2 + 1);
+        bits_.assign((bits + 63) / 64, 0);
+
+        const std::uint64_t root = detail::isqrt(hi_);
+        const std::size_t segmentWords = SIEVE_SEGMENT_BYTES / 8;
+        const std::size_t segments = (bits_.size() + segmentWords - 1) / segmentWords;
+        // Part p is segments [p * segments / parts, (p + 1) * segments / parts)
+        const std::size_t parts = pool ? std::min<std::size_t>(pool->size(), segments) : 1;
+        auto forEachPart = [&](auto body) {
+            auto run = [&](unsigned, std::size_t b, std::size_t e) {
+                for (std::size_t p = b; p < e; p++)
+                    body(p * segments / parts, (p + 1) * segments / parts);
+            };
+            if (pool)
+                pool->parallelFor(parts, 1, run);
+            else
+                run(0, 0, parts);
+        };
+        if (hi_ - lo_ < root / SIEVE_MILLER_RABIN_RATIO) {
+            forEachPart([&](std::size_t s0, std::size_t s1) { testSegments(s0, s1); });
+        } else {
+            std::vector<std::uint32_t> primes = basePrimes(root, pool);
+            forEachPart([&](std::size_t s0, std::size_t s1) { sieveSegments(s0, s1, primes); });
+        }
+
+        // The wheel removed its own primes and 1 is not prime
+        for (std::uint64_t p : {std::uint64_t(1), std::uint64_t(3), std::uint64_t(5), std::uint64_t(7),
+                                std::uint64_t(11), std::uint64_t(13)}) {
+            if (p < base_ || p > hi_)
+                continue;
+            std::size_t i = static_cast<std::size_t>((p - base_) / 2);
+            if (p == 1)
+                bits_[i >> 6] &= ~(std::uint64_t(1) << (i & 63));
+            else
+                bits_[i >> 6] |= std::uint64_t(1) << (i & 63);
+        }
+    }
+
+    std::uint64_t lo() const { return lo_; }
+    std::uint64_t hi() const { return hi_; }
+    bool empty() const { return bits_.empty(); }
+    bool contains(std::uint64_t n) const { return !bits_.empty() && n >= lo_ && n <= hi_; }
+
+    // n must be inside the range
+    bool isPrime(std::uint64_t n) const
+    {
+        if (n % 2 == 0)
+            return n == 2;
+        std::size_t i = static_cast<std::size_t>((n - base_) / 2);
+        return (bits_[i >> 6] >> (i & 63)) & 1;
+    }
+
+    // fn(p) for every prime of the range in ascending order
+    template <class F>
+    void forEachPrime(F fn) const
+    {
+        if (bits_.empty())
+            return;
+        if (lo_ <= 2 && hi_ >= 2)
+            fn(std::uint64_t(2));
+        for (std::size_t w = 0; w < bits_.size(); w++) {
+            std::uint64_t word = bits_[w];
+            while (word) {
+                std::uint64_t n = base_ + 2 * (w * 64 + __builtin_ctzll(word)) + 1;
+                word &= word - 1;
+                if (n >= lo_ && n <= hi_)
+                    fn(n);
+            }
+        }
+    }
+
+    std::uint64_t count() const
+    {
+        std::uint64_t total = 0;
+        forEachPrime([&](std::uint64_t) { total++; });
+        return total;
+    }
+
+private:
+    // A prime of a bucket and its next multiple as a bit of the segment
+    struct BucketEntry {
+        std::uint32_t prime, bit;
+    };
+
+    // The primes from 17 to limit
+    static std::vector<std::uint32_t> basePrimes(std::uint64_t limit, ThreadPool* pool)
+    {
+        std::vector<std::uint32_t> primes;
+        if (limit <= SIEVE_PLAIN_MAX) {
+            primes = detail::smallPrimes(static_cast<std::uint32_t>(limit));
+        } else {
+            for (std::uint64_t b = 0; b <= limit; b += SIEVE_BASE_BLOCK)
+                SievedRange(b, std::min(limit, b + SIEVE_BASE_BLOCK - 1), pool).forEachPrime([&](std::uint64_t p) {
+                    primes.push_back(static_cast<std::uint32_t>(p));
+                });
+        }
+        primes.erase(primes.begin(), std::upper_bound(primes.begin(), primes.end(), 13u));
+        return primes;
+    }
+
+    void fillWheel(std::size_t w0, std::size_t w1)
+    {
+        const std::vector<std::uint64_t>& wheel = detail::wheelPattern();
+        std::size_t offset = static_cast<std::size_t>((base_ / 128 + w0) % detail::WHEEL_WORDS);
+        for (std::size_t w = w0; w < w1; w++) {
+            bits_[w] = wheel[offset];
+            if (++offset == detail::WHEEL_WORDS)
+                offset = 0;
+        }
+    }
+
+    void clearBit(std::size_t i) { bits_[i >> 6] &= ~(std::uint64_t(1) << (i & 63)); }
+
+    // Sieve segments [s0, s1) in order
+    void sieveSegments(std::size_t s0, std::size_t s1, const std::vector<std::uint32_t>& primes)
+    {
+        const std::size_t segmentWords = SIEVE_SEGMENT_BYTES / 8, segmentBits = segmentWords * 64;
+        const std::size_t endBit = std::min(bits_.size(), s1 * segmentWords) * 64;
+        const std::uint64_t partLo = base_ + 128 * static_cast<std::uint64_t>(s0 * segmentWords) + 1; // first odd value
+        const std::uint64_t partHi = base_ + 2 * static_cast<std::uint64_t>(endBit); // one past the last
+
+        // The bit of the first odd multiple of p in the part, from p * p
+        auto firstBit = [&](std::uint64_t p) {
+            std::uint64_t m = std::max(p * p, (partLo + p - 1) / p * p);
+            if (m % 2 == 0)
+                m += p;
+            return static_cast<std::size_t>((m - base_) / 2);
+        };
+        std::vector<std::size_t> next;
+        std::vector<std::vector<BucketEntry>> buckets(s1 - s0);
+        std::size_t small = 0;
+        for (; small < primes.size() && primes[small] < segmentBits; small++) {
+            const std::uint64_t p = primes[small];
+            if (p * p >= partHi)
+                break;
+            next.push_back(firstBit(p));
+        }
+        for (std::size_t k = small; k < primes.size(); k++) {
+            const std::uint64_t p = primes[k];
+            if (p * p >= partHi)
+                break;
+            std::size_t i = firstBit(p);
+            if (i < endBit)
+                buckets[i / segmentBits - s0].push_back({primes[k], static_cast<std::uint32_t>(i % segmentBits)});
+        }
+
+        for (std::size_t s = s0; s < s1; s++) {
+            fillWheel(s * segmentWords, std::min(bits_.size(), (s + 1) * segmentWords));
+            const std::size_t segEnd = std::min(endBit, (s + 1) * segmentBits);
+            for (std::size_t k = 0; k < next.size(); k++) {
+                const std::size_t p = primes[k];
+                std::size_t i = next[k];
+                for (; i < segEnd; i += p)
+                    clearBit(i);
+                next[k] = i;
+            }
+            // A bucket prime is longer than the segment, so its next
+            // multiple lands in a later bucket
+            std::vector<BucketEntry> bucket;
+            bucket.swap(buckets[s - s0]);
+            for (const BucketEntry& entry : bucket) {
+                std::size_t i = s * segmentBits + entry.bit;
+                clearBit(i);
+                i += entry.prime;
+                if (i < endBit)
+                    buckets[i / segmentBits - s0].push_back({entry.prime, static_cast<std::uint32_t>(i % segmentBits)});
+            }
+        }
+    }
+
+    // Segments [s0, s1) by Miller-Rabin on the numbers the wheel leaves
+    void testSegments(std::size_t s0, std::size_t s1)
+    {
+        const std::size_t segmentWords = SIEVE_SEGMENT_BYTES / 8;
+        std::vector<std::uint64_t> numbers;
+        std::vector<std::size_t> index;
+        std::vector<std::uint8_t> prime;
+        for (std::size_t s = s0; s < s1; s++) {
+            const std::size_t w0 = s * segmentWords, w1 = std::min(bits_.size(), w0 + segmentWords);
+            fillWheel(w0, w1);
+            numbers.clear();
+            index.clear();
+            for (std::size_t w = w0; w < w1; w++) {
+                for (std::uint64_t word = bits_[w]; word; word &= word - 1) {
+                    std::size_t i = w * 64 + __builtin_ctzll(word);
+                    std::uint64_t n = base_ + 2 * static_cast<std::uint64_t>(i) + 1;
+                    if (n >= lo_ && n <= hi_) {
+                        numbers.push_back(n);
+                        index.push_back(i);
+                    }
+                }
+            }
+            prime.resize(numbers.size());
+            isPrimeBatch(numbers.data(), numbers.size(), prime.data());
+            for (std::size_t j = 0; j < numbers.size(); j++)
+                if (!prime[j])
+                    clearBit(index[j]);
+        }
+    }
+
+    std::uint64_t lo_ = 1, hi_ = 0, base_ = 0;
+    std::vector<std::uint64_t> bits_;
+};
+
+// Every prime of [lo, hi] in ascending order
+inline std::vector<std::uint64_t> primesInRange(std::uint64_t lo, std::uint64_t hi, ThreadPool* pool = nullptr)
+{
+    std::vector<std::uint64_t> primes;
+    SievedRange(lo, hi, pool).forEachPrime([&](std::uint64_t p) { primes.push_back(p); });
+    return primes;
+}
+
+// Sieved ranges, kept sorted by lo with none inside another, so the last
+// range starting at or below n is the only one that can contain it.
+class PrimeCache {
+public:
+    // Sieve [lo, hi] unless one range already covers it
+    void sieve(std::uint64_t lo, std::uint64_t hi, ThreadPool* pool = nullptr)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            const SievedRange* r = find(lo);
+            if (r && r->hi() >= hi)
+                return;
+        }
+        SievedRange range(lo, hi, pool);
+        if (range.empty())
+            return;
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        ranges_.erase(std::remove_if(ranges_.begin(), ranges_.end(),
+                                     [&](const SievedRange& r) { return r.lo() >= range.lo() && r.hi() <= range.hi(); }),
+                      ranges_.end());
+        auto at = std::lower_bound(ranges_.begin(), ranges_.end(), range.lo(),
+                                   [](const SievedRange& r, std::uint64_t v) { return r.lo() < v; });
+        ranges_.insert(at, std::move(range));
+    }
+
+    bool contains(std::uint64_t n) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return find(n) != nullptr;
+    }
+
+    // A bit test inside a sieved range, Miller-Rabin outside
+    bool isPrime(std::uint64_t n) const
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            if (const SievedRange* r = find(n))
+                return r->isPrime(n);
+        }
+        return algo::isPrime(n);
+    }
+
+    void clear()
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        ranges_.clear();
+    }
+
+private:
+    const SievedRange* find(std::uint64_t n) const
+    {
+        auto at = std::upper_bound(ranges_.begin(), ranges_.end(), n,
+                                   [](std::uint64_t v, const SievedRange& r) { return v < r.lo(); });
+        if (at == ranges_.begin())
+            return nullptr;
+        --at;
+        return at->contains(n) ? &*at : nullptr;
+    }
+
+    mutable std::shared_mutex mutex_;
+    std::vector<SievedRange> ranges_;
+};
+
+// The cache behind is_prime()
+inline PrimeCache& primeCache()
+{
+    static PrimeCache cache;
+    return cache;
+}
+
+// The original entry point. The answer is exact for every n, so k, the
+// number of random rounds, is ignored; numbers inside a range sieved with
+// primeCache().sieve() are answered from the cache.
+inline int is_prime(long long n, int k = 0)
+{
+    (void)k;
+    if (n <= 1)
+        return 0;
+    return primeCache().isPrime(static_cast<std::uint64_t>(n));
+}
+
+} // namespace algo
@@ -0,0 +1,287 @@
+// Introsort-style quick sort. Compared with the Lomuto partition() that
+// always pivots on arr[high], this version
+//  - picks the pivot by median-of-three, or Tukey's ninther on large ranges,
+//    so sorted and reverse-sorted input split evenly;
+//  - partitions three ways (Dutch national flag), so runs of keys equal to
+//    the pivot are finished in one pass instead of degrading to O(n^2);
+//  - recurses only into the smaller side and loops on the larger one, which
+//    bounds the stack at O(log n) frames;
+//  - finishes ranges of SORT_NETWORK_MAX or fewer elements with a sorting
+//    network for trivially copyable types. Other types finish ranges of
+//    QUICK_SORT_CUTOFF or fewer with an insertion sort, unguarded for every
+//    range but the leftmost;
+//  - switches to heap sort once the depth passes 2 log2 n, for an
+//    O(n log n) worst case.
+// quickSortInt() is the same loop for int keys on the branch-free and SIMD
+// kernels of partition_kernels.hpp. parallelQuickSort() forks both sides of
+// the partitions above QUICK_SORT_TASK_CUTOFF on a TaskPool.
+#pragma once
+
+#include <climits>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "counters.hpp"
+#include "insertion_sort.hpp"
+#include "partition_kernels.hpp"
+#include "span.hpp"
+#include "task_pool.hpp"
+
+namespace algo {
+
+const std::size_t QUICK_SORT_CUTOFF = 24;
+
+// Above this size the pivot is the ninther rather than median-of-three.
+const std::size_t NINTHER_THRESHOLD = 128;
+
+// parallelQuickSort() sorts ranges of at most this many elements in one task
+const std::size_t QUICK_SORT_TASK_CUTOFF = 1 << 14;
+
+template <class T, class Compare = std::less<T>>
+void heapSort(T* arr, std::size_t n, Compare comp = Compare())
+{
+    auto less = countComparisons(comp);
+    auto siftDown = [&](std::size_t i, std::size_t size) {
+        T value = std::move(arr[i]);
+        for (;;) {
+            std::size_t child = 2 * i + 1;
+            if (child >= size)
+                break;
+            if (child + 1 < size && less(arr[child], arr[child + 1]))
+                child++;
+            if (!less(value, arr[child]))
+                break;
+            arr[i] = std::move(arr[child]);
+            ALGO_COUNT(moves, 1);
+            i = child;
+        }
+        arr[i] = std::move(value);
+    };
+
+    for (std::size_t i = n / 2; i-- > 0;)
+        siftDown(i, n);
+    for (std::size_t end = n; end-- > 1;) {
+        std::swap(arr[0], arr[end]);
+        ALGO_COUNT(moves, 1);
+        siftDown(0, end);
+    }
+}
+
+namespace detail {
+
+template <class T, class Compare>
+std::size_t medianOfThree(const T* arr, std::size_t a, std::size_t b, std::size_t c, Compare comp)
+{
+    if (comp(arr[a], arr[b])) {
+        if (comp(arr[b], arr[c]))
+            return b;
+        return comp(arr[a], arr[c]) ? c : a;
+    }
+    if (comp(arr[a], arr[c]))
+        return a;
+    return comp(arr[b], arr[c]) ? c : b;
+}
+
+template <class T, class Compare>
+std::size_t choosePivot(const T* arr, std::size_t n, Compare comp)
+{
+    std::size_t mid = n / 2, last = n - 1;
+    if (n <= NINTHER_THRESHOLD)
+        return medianOfThree(arr, 0, mid, last, comp);
+    std::size_t s = n / 8;
+    return medianOfThree(arr, medianOfThree(arr, 0, s, 2 * s, comp),
+                         medianOfThree(arr, mid - s, mid, mid + s, comp),
+                         medianOfThree(arr, last - 2 * s, last - s, last, comp), comp);
+}
+
+// Dutch national flag partition around pivot: on return arr[0..lt) < pivot,
+// arr[lt..gt) == pivot and arr[gt..n) > pivot.
+template <class T, class Compare>
+void partition3(T* arr, std::size_t n, const T& pivot, std::size_t& lt, std::size_t& gt, Compare comp)
+{
+    std::size_t i = 0;
+    lt = 0;
+    gt = n;
+    while (i < gt) {
+        if (comp(arr[i], pivot))
+            std::swap(arr[lt++], arr[i++]);
+        else if (comp(pivot, arr[i]))
+            std::swap(arr[i], arr[--gt]);
+        else
+            i++;
+    }
+    // Every element outside the equal run was swapped once
+    ALGO_COUNT(moves, lt + (n - gt));
+}
+
+// Ranges this short are not partitioned further
+template <class T>
+constexpr std::size_t leafCutoff()
+{
+    return std::is_trivially_copyable<T>::value ? SORT_NETWORK_MAX : QUICK_SORT_CUTOFF;
+}
+
+// Sort a range the introsort loops have cut down to leafCutoff(). A
+// range that is not leftmost follows a pivot no greater than any of its
+// elements, which stops the unguarded insertion loop.
+template <class T, class Compare>
+void sortLeaf(T* arr, std::size_t n, bool leftmost, Compare comp)
+{
+    if (std::is_trivially_copyable<T>::value && n <= SORT_NETWORK_MAX)
+        networkSort(arr, n, comp);
+    else if (leftmost)
+        insertionSort(arr, n, comp);
+    else
+        unguardedInsertionSort(arr, n, comp);
+}
+
+template <class T, class Compare>
+void introSortLoop(T* arr, std::size_t n, int depth, bool leftmost, Compare comp)
+{
+    ALGO_DEPTH_SCOPE();
+    while (n > leafCutoff<T>()) {
+        if (depth == 0) {
+            heapSort(arr, n, comp);
+            return;
+        }
+        depth--;
+
+        T pivot = arr[choosePivot(arr, n, comp)];
+        std::size_t lt, gt;
+        partition3(arr, n, pivot, lt, gt, comp);
+
+        // Recurse into the smaller side, loop on the larger one
+        if (lt < n - gt) {
+            introSortLoop(arr, lt, depth, leftmost, comp);
+            arr += gt;
+            n -= gt;
+            leftmost = false;
+        } else {
+            introSortLoop(arr + gt, n - gt, depth, false, comp);
+            n = lt;
+        }
+    }
+    sortLeaf(arr, n, leftmost, comp);
+}
+
+inline int depthLimit(std::size_t n)
+{
+    int log2n = 0;
+    while (n >>= 1)
+        log2n++;
+    return 2 * log2n;
+}
+
+// Introsort loop for int keys on a two-way partitionLess() kernel. The
+// pivot is parked at arr[0] during the partition and then dropped between
+// the two sides, so every round makes progress. Duplicates are handled the
+// pdqsort way: when the pivot equals the element just before the range
+// (the previous pivot), every key equal to it is split off in one pass.
+inline void introSortIntLoop(int* arr, std::size_t n, int depth, bool leftmost, PartitionKernel kernel)
+{
+    ALGO_DEPTH_SCOPE();
+    while (n > leafCutoff<int>()) {
+        if (depth == 0) {
+            heapSort(arr, n);
+            return;
+        }
+        depth--;
+
+        std::swap(arr[0], arr[choosePivot(arr, n, std::less<int>())]);
+        int pivot = arr[0];
+
+        if (!leftmost && arr[-1] == pivot) {
+            std::size_t equal = pivot == INT_MAX ? n : 1 + partitionLess(arr + 1, n - 1, pivot + 1, kernel);
+            // The kernels compare and write every key once
+            ALGO_COUNT(comparisons, n - 1);
+            ALGO_COUNT(moves, n - 1);
+            arr += equal;
+            n -= equal;
+            continue;
+        }
+
+        std::size_t k = partitionLess(arr + 1, n - 1, pivot, kernel);
+        std::swap(arr[0], arr[k]);
+        ALGO_COUNT(comparisons, n - 1);
+        ALGO_COUNT(moves, n + 1);
+
+        // [0, k) < pivot, arr[k] == pivot, [k + 1, n) >= pivot
+        if (k < n - k - 1) {
+            introSortIntLoop(arr, k, depth, leftmost, kernel);
+            arr += k + 1;
+            n -= k + 1;
+            leftmost = false;
+        } else {
+            introSortIntLoop(arr + k + 1, n - k - 1, depth, false, kernel);
+            n = k;
+        }
+    }
+    sortLeaf(arr, n, leftmost, std::less<int>());
+}
+
+// introSortLoop() with both sides of each partition as tasks. A right side
+// keeps the pivot run just before it, which no other task writes, so its
+// unguarded insertion leaves stay safe.
+template <class T, class Compare>
+void introSortTasks(T* arr, std::size_t n, int depth, bool leftmost, TaskPool& pool, Compare comp)
+{
+    if (n <= QUICK_SORT_TASK_CUTOFF || depth == 0) {
+        introSortLoop(arr, n, depth, leftmost, comp);
+        return;
+    }
+    T pivot = arr[choosePivot(arr, n, comp)];
+    std::size_t lt, gt;
+    partition3(arr, n, pivot, lt, gt, comp);
+    pool.invoke([&] { introSortTasks(arr, lt, depth - 1, leftmost, pool, comp); },
+                [&] { introSortTasks(arr + gt, n - gt, depth - 1, false, pool, comp); });
+}
+
+} // namespace detail
+
+template <class T, class Compare = std::less<T>>
+void quickSort(T* arr, std::size_t n, Compare comp = Compare())
+{
+    detail::introSortLoop(arr, n, detail::depthLimit(n), true, countComparisons(comp));
+}
+
+// quickSort() for int keys with a selectable partition kernel; Auto uses the
+// fastest one this CPU supports.
+inline void quickSortInt(int* arr, std::size_t n, PartitionKernel kernel = PartitionKernel::Auto)
+{
+    if (kernel == PartitionKernel::Auto)
+        kernel = bestPartitionKernel();
+    detail::introSortIntLoop(arr, n, detail::depthLimit(n), true, kernel);
+}
+
+// quickSort() on a TaskPool; it may be called from inside another task
+template <class T, class Compare = std::less<T>>
+void parallelQuickSort(T* arr, std::size_t n, TaskPool& pool, Compare comp = Compare())
+{
+    if (pool.size() == 1 || n <= QUICK_SORT_TASK_CUTOFF) {
+        quickSort(arr, n, comp);
+        return;
+    }
+    pool.run([&] { detail::introSortTasks(arr, n, detail::depthLimit(n), true, pool, countComparisons(comp)); });
+}
+
+template <class T, class Compare = std::less<T>>
+void quickSort(Span<T> s, Compare comp = Compare())
+{
+    quickSort(s.data(), s.size(), comp);
+}
+
+template <class T, class Compare = std::less<T>>
+void heapSort(Span<T> s, Compare comp = Compare())
+{
+    heapSort(s.data(), s.size(), comp);
+}
+
+template <class T, class Compare = std::less<T>>
+void parallelQuickSort(Span<T> s, TaskPool& pool, Compare comp = Compare())
+{
+    parallelQuickSort(s.data(), s.size(), pool, comp);
+}
+
+} // namespace algo
@@ -0,0 +1,230 @@
+// LSD radix sort for 32- and 64-bit integer keys, called like mergeSort()
+// and quickSort(): radixSort(arr, n). Keys are split into 11-bit digits
+// (3 passes for 32-bit keys, 6 for 64-bit); one read computes the
+// histograms for every pass, passes whose digit is the same for all keys
+// are skipped, and the data ping-pongs with a single buffer. Signed keys
+// have their sign bit flipped so negatives sort first. The sort is stable.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+namespace algo {
+
+const int RADIX_BITS = 11;
+const std::size_t RADIX_BUCKETS = std::size_t(1) << RADIX_BITS;
+
+// How far ahead of the read position the histogram and scatter loops prefetch.
+const std::size_t RADIX_PREFETCH = 64;
+
+template <class K>
+typename std::make_unsigned<K>::type radixKey(K key)
+{
+    static_assert(std::is_integral<K>::value, "radix sort needs integer keys");
+    using U = typename std::make_unsigned<K>::type;
+    U u = static_cast<U>(key);
+    if (std::is_signed<K>::value)
+        u ^= U(1) << (sizeof(K) * 8 - 1);
+    return u;
+}
+
+namespace detail {
+
+template <class K>
+constexpr int radixPasses()
+{
+    return static_cast<int>((sizeof(K) * 8 + RADIX_BITS - 1) / RADIX_BITS);
+}
+
+template <class K>
+std::size_t radixDigit(K key, int pass)
+{
+    return static_cast<std::size_t>(radixKey(key) >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1);
+}
+
+template <class K, class V, bool Payload>
+void lsdRadixSort(K* keys, K* keyBuf, V* vals, V* valBuf, std::size_t n)
+{
+    constexpr int passes = radixPasses<K>();
+    std::vector<std::size_t> hist(passes * RADIX_BUCKETS, 0);
+    for (std::size_t i = 0; i < n; i++) {
+        __builtin_prefetch(keys + i + RADIX_PREFETCH);
+        for (int p = 0; p < passes; p++)
+            hist[p * RADIX_BUCKETS + radixDigit(keys[i], p)]++;
+    }
+
+    K* src = keys;
+    K* dst = keyBuf;
+    V* vsrc = vals;
+    V* vdst = valBuf;
+    for (int p = 0; p < passes; p++) {
+        std::size_t* count = &hist[p * RADIX_BUCKETS];
+        if (count[radixDigit(src[0], p)] == n)
+            continue;
+        std::size_t sum = 0;
+        for (std::size_t d = 0; d < RADIX_BUCKETS; d++) {
+            std::size_t c = count[d];
+            count[d] = sum;
+            sum += c;
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            __builtin_prefetch(src + i + RADIX_PREFETCH);
+            std::size_t pos = count[radixDigit(src[i], p)]++;
+            dst[pos] = src[i];
+            if constexpr (Payload)
+                vdst[pos] = vsrc[i];
+        }
+        std::swap(src, dst);
+        std::swap(vsrc, vdst);
+    }
+
+    if (src != keys) {
+        std::copy(src, src + n, keys);
+        if constexpr (Payload)
+            std::copy(vsrc, vsrc + n, vals);
+    }
+}
+
+// Per pass: every worker histograms its own contiguous chunk, the counts are
+// prefix-summed digit-major then chunk-major (which keeps the sort stable),
+// and each worker scatters its chunk to its own reserved slots. Pool is a
+// ThreadPool or a TaskPool; only size() and parallelFor() are used.
+template <class K, class V, bool Payload, class Pool>
+void parallelLsdRadixSort(K* keys, K* keyBuf, V* vals, V* valBuf, std::size_t n, Pool& pool)
+{
+    constexpr int passes = radixPasses<K>();
+    const std::size_t chunks = pool.size();
+    const std::size_t width = (n + chunks - 1) / chunks;
+    std::vector<std::size_t> counts(chunks * RADIX_BUCKETS);
+
+    K* src = keys;
+    K* dst = keyBuf;
+    V* vsrc = vals;
+    V* vdst = valBuf;
+    for (int p = 0; p < passes; p++) {
+        pool.parallelFor(chunks, 1, [&](unsigned, std::size_t b, std::size_t e) {
+            for (std::size_t c = b; c < e; c++) {
+                std::size_t* count = &counts[c * RADIX_BUCKETS];
+                std::fill(count, count + RADIX_BUCKETS, 0);
+                std::size_t lo = c * width, hi = std::min(n, lo + width);
+                for (std::size_t i = lo; i < hi; i++) {
+                    __builtin_prefetch(src + i + RADIX_PREFETCH);
+                    count[radixDigit(src[i], p)]++;
+                }
+            }
+        });
+
+        std::size_t first = radixDigit(src[0], p), same = 0;
+        for (std::size_t c = 0; c < chunks; c++)
+            same += counts[c * RADIX_BUCKETS + first];
+        if (same == n)
+            continue;
+
+        std::size_t sum = 0;
+        for (std::size_t d = 0; d < RADIX_BUCKETS; d++)
+            for (std::size_t c = 0; c < chunks; c++) {
+                std::size_t t = counts[c * RADIX_BUCKETS + d];
+                counts[c * RADIX_BUCKETS + d] = sum;
+                sum += t;
+            }
+
+        pool.parallelFor(chunks, 1, [&](unsigned, std::size_t b, std::size_t e) {
+            for (std::size_t c = b; c < e; c++) {
+                std::size_t* count = &counts[c * RADIX_BUCKETS];
+                std::size_t lo = c * width, hi = std::min(n, lo + width);
+                for (std::size_t i = lo; i < hi; i++) {
+                    __builtin_prefetch(src + i + RADIX_PREFETCH);
+                    std::size_t pos = count[radixDigit(src[i], p)]++;
+                    dst[pos] = src[i];
+                    if constexpr (Payload)
+                        vdst[pos] = vsrc[i];
+                }
+            }
+        });
+        std::swap(src, dst);
+        std::swap(vsrc, vdst);
+    }
+
+    if (src != keys) {
+        pool.parallelFor(n, 0, [&](unsigned, std::size_t b, std::size_t e) {
+            std::copy(src + b, src + e, keys + b);
+            if constexpr (Payload)
+                std::copy(vsrc + b, vsrc + e, vals + b);
+        });
+    }
+}
+
+} // namespace detail
+
+// Sort arr[0..n) using the caller's scratch buffer of at least n elements.
+template <class K>
+void radixSortWithBuffer(K* arr, std::size_t n, K* scratch)
+{
+    if (n < 2)
+        return;
+    detail::lsdRadixSort<K, char, false>(arr, scratch, nullptr, nullptr, n);
+}
+
+template <class K>
+void radixSort(K* arr, std::size_t n)
+{
+    std::vector<K> scratch(n);
+    radixSortWithBuffer(arr, n, scratch.data());
+}
+
+// Sort keys and carry payload[i] along with keys[i].
+template <class K, class V>
+void radixSortPairs(K* keys, V* payload, std::size_t n)
+{
+    if (n < 2)
+        return;
+    std::vector<K> keyBuf(n);
+    std::vector<V> valBuf(n);
+    detail::lsdRadixSort<K, V, true>(keys, keyBuf.data(), payload, valBuf.data(), n);
+}
+
+// Stable sorting permutation: on return keys[index[0]] <= keys[index[1]] <= ...
+// The keys themselves are left untouched.
+template <class K>
+std::vector<std::uint32_t> radixSortIndices(const K* keys, std::size_t n)
+{
+    std::vector<K> copy(keys, keys + n);
+    std::vector<std::uint32_t> index(n);
+    for (std::size_t i = 0; i < n; i++)
+        index[i] = static_cast<std::uint32_t>(i);
+    radixSortPairs(copy.data(), index.data(), n);
+    return index;
+}
+
+template <class K>
+void parallelRadixSort(K* arr, std::size_t n, ThreadPool& pool)
+{
+    if (n < 2)
+        return;
+    std::vector<K> scratch(n);
+    if (pool.size() == 1)
+        detail::lsdRadixSort<K, char, false>(arr, scratch.data(), nullptr, nullptr, n);
+    else
+        detail::parallelLsdRadixSort<K, char, false>(arr, scratch.data(), nullptr, nullptr, n, pool);
+}
+
+template <class K, class V>
+void parallelRadixSortPairs(K* keys, V* payload, std::size_t n, ThreadPool& pool)
+{
+    if (n < 2)
+        return;
+    std::vector<K> keyBuf(n);
+    std::vector<V> valBuf(n);
+    if (pool.size() == 1)
+        detail::lsdRadixSort<K, V, true>(keys, keyBuf.data(), payload, valBuf.data(), n);
+    else
+        detail::parallelLsdRadixSort<K, V, true>(keys, keyBuf.data(), payload, valBuf.data(), n, pool);
+}
+
+} // namespace algo
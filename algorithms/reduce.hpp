@@ -0,0 +1,323 @@
+// Reductions over a column: min/max, sum, argmin, argmax. The original
+// maxMinDivideConquer() recurses down to one or two elements and returns a
+// struct by value at every level, a call and a copy per two elements.
+//
+// Here the recursion stops at REDUCE_GRAIN elements, which a straight loop
+// reduces, and on a TaskPool the two halves of every level above run as
+// tasks, merged on the way back up.
+//
+//  - minMax(): int columns use AVX-512 or AVX2 min/max lanes. Other types,
+//    and CPUs without them, use the pairwise scan: the smaller of each pair
+//    is compared with the minimum and the larger with the maximum, 3n / 2
+//    comparisons. ReduceKernel::Auto picks the widest kernel at runtime.
+//  - reduce(): any Reducer with an Acc type, identity(), fold(acc, i, x)
+//    and merge(acc, other). Each chunk folds into REDUCE_LANES independent
+//    accumulators (element i into lane i % REDUCE_LANES), so simple folds
+//    vectorise and the others keep several dependency chains going.
+//    merge() sees partial results in no fixed order.
+//    SumReducer, ArgMinReducer, ArgMaxReducer and MinMaxReducer share this
+//    kernel.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "simd.hpp"
+#include "task_pool.hpp"
+
+namespace algo {
+
+enum class ReduceKernel { Auto, Scalar, Avx2, Avx512 };
+
+// Elements per parallel chunk
+const std::size_t REDUCE_GRAIN = std::size_t(1) << 16;
+const int REDUCE_LANES = 8;
+
+// {max(), lowest()} for an empty range
+template <class T>
+struct MinMax {
+    T min = std::numeric_limits<T>::max();
+    T max = std::numeric_limits<T>::lowest();
+};
+
+template <class T>
+MinMax<T> minMaxPairwise(const T* arr, std::size_t n)
+{
+    MinMax<T> r;
+    std::size_t i = 0;
+    if (n & 1) {
+        r.min = r.max = arr[0];
+        i = 1;
+    }
+    for (; i + 1 < n; i += 2) {
+        const T& a = arr[i];
+        const T& b = arr[i + 1];
+        if (b < a) {
+            if (b < r.min)
+                r.min = b;
+            if (r.max < a)
+                r.max = a;
+        } else {
+            if (a < r.min)
+                r.min = a;
+            if (r.max < b)
+                r.max = b;
+        }
+    }
+    return r;
+}
+
+#ifdef ALGO_X86_SIMD
+
+__attribute__((target("avx2"))) inline MinMax<int> minMaxAvx2(const int* arr, std::size_t n)
+{
+    __m256i lo0 = _mm256_set1_epi32(std::numeric_limits<int>::max()), lo1 = lo0;
+    __m256i hi0 = _mm256_set1_epi32(std::numeric_limits<int>::min()), hi1 = hi0;
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(arr + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(arr + i + 8));
+        lo0 = _mm256_min_epi32(lo0, a);
+        hi0 = _mm256_max_epi32(hi0, a);
+        lo1 = _mm256_min_epi32(lo1, b);
+        hi1 = _mm256_max_epi32(hi1, b);
+    }
+    alignas(32) int lo[8], hi[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lo), _mm256_min_epi32(lo0, lo1));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(hi), _mm256_max_epi32(hi0, hi1));
+    MinMax<int> r = minMaxPairwise(arr + i, n - i);
+    for (int l = 0; l < 8; l++) {
+        r.min = lo[l] < r.min ? lo[l] : r.min;
+        r.max = hi[l] > r.max ? hi[l] : r.max;
+    }
+    return r;
+}
+
+// The write-masked forms with an all-ones mask: the plain ones start from
+// an undefined vector, which GCC 12 reports under -Wall.
+__attribute__((target("avx512f"))) inline MinMax<int> minMaxAvx512(const int* arr, std::size_t n)
+{
+    const __mmask16 all = 0xFFFF;
+    __m512i lo0 = _mm512_set1_epi32(std::numeric_limits<int>::max()), lo1 = lo0;
+    __m512i hi0 = _mm512_set1_epi32(std::numeric_limits<int>::min()), hi1 = hi0;
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m512i a = _mm512_loadu_si512(arr + i);
+        __m512i b = _mm512_loadu_si512(arr + i + 16);
+        lo0 = _mm512_mask_min_epi32(lo0, all, lo0, a);
+        hi0 = _mm512_mask_max_epi32(hi0, all, hi0, a);
+        lo1 = _mm512_mask_min_epi32(lo1, all, lo1, b);
+        hi1 = _mm512_mask_max_epi32(hi1, all, hi1, b);
+    }
+    alignas(64) int lo[16], hi[16];
+    _mm512_store_si512(lo, _mm512_mask_min_epi32(lo0, all, lo0, lo1));
+    _mm512_store_si512(hi, _mm512_mask_max_epi32(hi0, all, hi0, hi1));
+    MinMax<int> r = minMaxPairwise(arr + i, n - i);
+    for (int l = 0; l < 16; l++) {
+        r.min = lo[l] < r.min ? lo[l] : r.min;
+        r.max = hi[l] > r.max ? hi[l] : r.max;
+    }
+    return r;
+}
+
+#endif // ALGO_X86_SIMD
+
+inline bool reduceKernelSupported(ReduceKernel kernel)
+{
+    switch (kernel) {
+    case ReduceKernel::Auto:
+    case ReduceKernel::Scalar:
+        return true;
+#ifdef ALGO_X86_SIMD
+    case ReduceKernel::Avx2:
+        return __builtin_cpu_supports("avx2");
+    case ReduceKernel::Avx512:
+        return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+        return false;
+    }
+}
+
+// The kernel Auto resolves to on this CPU.
+inline ReduceKernel bestReduceKernel()
+{
+    static const ReduceKernel best = reduceKernelSupported(ReduceKernel::Avx512) ? ReduceKernel::Avx512
+                                     : reduceKernelSupported(ReduceKernel::Avx2) ? ReduceKernel::Avx2
+                                                                                 : ReduceKernel::Scalar;
+    return best;
+}
+
+namespace detail {
+
+// chunk(begin, end) on [b, e) split in halves down to REDUCE_GRAIN, both
+// halves as tasks, merged on the way back up
+template <class Acc, class Chunk, class Merge>
+Acc reduceTasks(std::size_t b, std::size_t e, TaskPool& pool, Chunk& chunk, Merge& merge)
+{
+    if (e - b <= REDUCE_GRAIN)
+        return chunk(b, e);
+    const std::size_t mid = b + (e - b) / 2;
+    Acc left, right;
+    pool.invoke([&] { left = reduceTasks<Acc>(b, mid, pool, chunk, merge); },
+                [&] { right = reduceTasks<Acc>(mid, e, pool, chunk, merge); });
+    merge(left, right);
+    return left;
+}
+
+// reduceTasks() over [0, n) on pool, or one chunk without it
+template <class Acc, class Chunk, class Merge>
+Acc reduceSplit(std::size_t n, TaskPool* pool, Chunk chunk, Merge merge)
+{
+    if (!pool || pool->size() == 1 || n <= REDUCE_GRAIN)
+        return chunk(std::size_t(0), n);
+    Acc result;
+    pool->run([&] { result = reduceTasks<Acc>(0, n, *pool, chunk, merge); });
+    return result;
+}
+
+inline MinMax<int> minMaxChunk(const int* arr, std::size_t n, ReduceKernel kernel)
+{
+#ifdef ALGO_X86_SIMD
+    if (kernel == ReduceKernel::Avx512)
+        return minMaxAvx512(arr, n);
+    if (kernel == ReduceKernel::Avx2)
+        return minMaxAvx2(arr, n);
+#endif
+    (void)kernel;
+    return minMaxPairwise(arr, n);
+}
+
+} // namespace detail
+
+template <class T>
+void mergeMinMax(MinMax<T>& acc, const MinMax<T>& other)
+{
+    if (other.min < acc.min)
+        acc.min = other.min;
+    if (acc.max < other.max)
+        acc.max = other.max;
+}
+
+// Min and max of arr[0..n), split over pool when given
+template <class T>
+MinMax<T> minMax(const T* arr, std::size_t n, TaskPool* pool = nullptr)
+{
+    return detail::reduceSplit<MinMax<T>>(
+        n, pool, [&](std::size_t b, std::size_t e) { return minMaxPairwise(arr + b, e - b); }, mergeMinMax<T>);
+}
+
+// minMax() for int with SIMD lanes. Unsupported kernels fall back to
+// Scalar, the pairwise scan.
+inline MinMax<int> minMax(const int* arr, std::size_t n, TaskPool* pool = nullptr,
+                          ReduceKernel kernel = ReduceKernel::Auto)
+{
+    if (kernel == ReduceKernel::Auto)
+        kernel = bestReduceKernel();
+    if (!reduceKernelSupported(kernel))
+        kernel = ReduceKernel::Scalar;
+    return detail::reduceSplit<MinMax<int>>(
+        n, pool, [&](std::size_t b, std::size_t e) { return detail::minMaxChunk(arr + b, e - b, kernel); },
+        mergeMinMax<int>);
+}
+
+// The original entry point over arr[low..high]
+inline MinMax<int> maxMinDivideConquer(const int arr[], int low, int high, TaskPool* pool = nullptr)
+{
+    return minMax(arr + low, static_cast<std::size_t>(high - low + 1), pool);
+}
+
+namespace detail {
+
+// One chunk of reduce(), folded into REDUCE_LANES lanes
+template <class T, class Reducer>
+typename Reducer::Acc reduceLanes(const T* arr, std::size_t b, std::size_t e, const Reducer& reducer)
+{
+    using Acc = typename Reducer::Acc;
+    Acc lane[REDUCE_LANES];
+    for (Acc& a : lane)
+        a = reducer.identity();
+    std::size_t i = b;
+    for (; i + REDUCE_LANES <= e; i += REDUCE_LANES)
+        for (int l = 0; l < REDUCE_LANES; l++)
+            reducer.fold(lane[l], i + l, arr[i + l]);
+    for (int l = 0; i < e; i++, l++)
+        reducer.fold(lane[l], i, arr[i]);
+    for (int l = 1; l < REDUCE_LANES; l++)
+        reducer.merge(lane[0], lane[l]);
+    return lane[0];
+}
+
+} // namespace detail
+
+template <class T, class Reducer>
+typename Reducer::Acc reduce(const T* arr, std::size_t n, const Reducer& reducer, TaskPool* pool = nullptr)
+{
+    using Acc = typename Reducer::Acc;
+    return detail::reduceSplit<Acc>(
+        n, pool, [&](std::size_t b, std::size_t e) { return detail::reduceLanes(arr, b, e, reducer); },
+        [&](Acc& acc, const Acc& other) { reducer.merge(acc, other); });
+}
+
+// Integers sum in 64 bits, floating point in at least double
+template <class T>
+struct SumReducer {
+    using Acc = typename std::conditional<
+        std::is_integral<T>::value,
+        typename std::conditional<std::is_signed<T>::value, long long, unsigned long long>::type,
+        typename std::common_type<T, double>::type>::type;
+    Acc identity() const { return Acc(0); }
+    void fold(Acc& acc, std::size_t, const T& x) const { acc += x; }
+    void merge(Acc& acc, const Acc& other) const { acc += other; }
+};
+
+// index is SIZE_MAX on an empty range
+template <class T>
+struct ArgResult {
+    T value;
+    std::size_t index;
+};
+
+// The first index of the minimum
+template <class T>
+struct ArgMinReducer {
+    using Acc = ArgResult<T>;
+    Acc identity() const { return {std::numeric_limits<T>::max(), SIZE_MAX}; }
+    void fold(Acc& acc, std::size_t i, const T& x) const
+    {
+        bool better = x < acc.value || (!(acc.value < x) && i < acc.index);
+        acc.value = better ? x : acc.value;
+        acc.index = better ? i : acc.index;
+    }
+    void merge(Acc& acc, const Acc& other) const { fold(acc, other.index, other.value); }
+};
+
+// The first index of the maximum
+template <class T>
+struct ArgMaxReducer {
+    using Acc = ArgResult<T>;
+    Acc identity() const { return {std::numeric_limits<T>::lowest(), SIZE_MAX}; }
+    void fold(Acc& acc, std::size_t i, const T& x) const
+    {
+        bool better = acc.value < x || (!(x < acc.value) && i < acc.index);
+        acc.value = better ? x : acc.value;
+        acc.index = better ? i : acc.index;
+    }
+    void merge(Acc& acc, const Acc& other) const { fold(acc, other.index, other.value); }
+};
+
+template <class T>
+struct MinMaxReducer {
+    using Acc = MinMax<T>;
+    Acc identity() const { return Acc(); }
+    void fold(Acc& acc, std::size_t, const T& x) const
+    {
+        acc.min = x < acc.min ? x : acc.min;
+        acc.max = acc.max < x ? x : acc.max;
+    }
+    void merge(Acc& acc, const Acc& other) const { mergeMinMax(acc, other); }
+};
+
+} // namespace algo
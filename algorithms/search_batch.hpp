@@ -0,0 +1,121 @@
+// Batched lookups of many keys in one sorted int table. Calling
+// binarySearch() once per key waits for one cache miss at a time; here each
+// thread keeps SEARCH_GROUP searches going at once, and results go to a
+// caller-provided array.
+//
+//  - binarySearchBatch(): groups of keys walk the plain sorted layout in
+//    lockstep. The branchless search takes the same number of halving steps
+//    for every key, so a group does each step for all of its keys, then
+//    prefetches each key's next probe.
+//  - findBatch(): the same over an EytzingerIndex.
+//  - binarySearchSortedBatch(): ascending keys are merged with the table.
+//    Each key gallops forward from the previous answer, so a dense batch
+//    reads the table once in order.
+//
+// The pool splits the keys into chunks; a sorted chunk starts with one
+// ordinary search for its first key. results[i] is the index of keys[i] or
+// -1, the first copy when the table has duplicates.
+#pragma once
+
+#include <cstddef>
+
+#include "search_index.hpp"
+#include "thread_pool.hpp"
+
+namespace algo {
+
+// Keys per parallel chunk
+const std::size_t SEARCH_BATCH_GRAIN = 4096;
+
+namespace detail {
+
+inline void binarySearchGroup(const int* arr, int n, const int* keys, int count, int* results)
+{
+    const int* base[SEARCH_GROUP];
+    for (int l = 0; l < count; l++)
+        base[l] = arr;
+    int len = n;
+    while (len > 1) {
+        int half = len / 2, probe = (len - half) / 2 - 1;
+        for (int l = 0; l < count; l++) {
+            base[l] += base[l][half - 1] < keys[l] ? half : 0;
+            __builtin_prefetch(base[l] + (probe > 0 ? probe : 0));
+        }
+        len -= half;
+    }
+    for (int l = 0; l < count; l++) {
+        int i = static_cast<int>(base[l] - arr) + (*base[l] < keys[l]);
+        results[l] = i < n && arr[i] == keys[l] ? i : -1;
+    }
+}
+
+// The first index at or after from whose value is >= key, arr[from - 1] < key
+inline int gallopLowerBound(const int* arr, int n, int from, int key)
+{
+    int lo = from, probe = from, step = 1;
+    while (probe < n && arr[probe] < key) {
+        lo = probe + 1;
+        probe += step;
+        step *= 2;
+    }
+    int hi = probe < n ? probe : n;
+    return lo + lowerBoundBranchless(arr + lo, hi - lo, key);
+}
+
+template <class Chunk>
+void searchChunks(std::size_t count, ThreadPool* pool, Chunk chunk)
+{
+    if (pool)
+        pool->parallelFor(count, SEARCH_BATCH_GRAIN, [&](unsigned, std::size_t b, std::size_t e) { chunk(b, e); });
+    else
+        chunk(0, count);
+}
+
+} // namespace detail
+
+// results[i] = binarySearch(arr, n, keys[i]) for i < count
+inline void binarySearchBatch(const int arr[], int n, const int* keys, std::size_t count, int* results,
+                              ThreadPool* pool = nullptr)
+{
+    if (n <= 0) {
+        for (std::size_t i = 0; i < count; i++)
+            results[i] = -1;
+        return;
+    }
+    detail::searchChunks(count, pool, [&](std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; i += SEARCH_GROUP) {
+            int g = static_cast<int>(e - i < std::size_t(SEARCH_GROUP) ? e - i : SEARCH_GROUP);
+            detail::binarySearchGroup(arr, n, keys + i, g, results + i);
+        }
+    });
+}
+
+// results[i] = index.find(keys[i]) for i < count
+inline void findBatch(const EytzingerIndex& index, const int* keys, std::size_t count, int* results,
+                      ThreadPool* pool = nullptr)
+{
+    detail::searchChunks(count, pool, [&](std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; i += SEARCH_GROUP) {
+            int g = static_cast<int>(e - i < std::size_t(SEARCH_GROUP) ? e - i : SEARCH_GROUP);
+            index.findGroup(keys + i, g, results + i);
+        }
+    });
+}
+
+// binarySearchBatch() for keys in ascending order, by merging
+inline void binarySearchSortedBatch(const int arr[], int n, const int* keys, std::size_t count, int* results,
+                                    ThreadPool* pool = nullptr)
+{
+    detail::searchChunks(count, pool, [&](std::size_t b, std::size_t e) {
+        int at = 0;
+        for (std::size_t i = b; i < e; i++) {
+            if (i == b)
+                at = lowerBoundBranchless(arr, n, keys[i]);
+            else if (at < n && arr[at] < keys[i])
+                at = detail::gallopLowerBound(arr, n, at + 1, keys[i]);
+            results[i] = at < n && arr[at] == keys[i] ? at : -1;
+        }
+    });
+}
+
+} // namespace algo
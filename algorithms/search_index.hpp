@@ -0,0 +1,354 @@
+// Static search indexes over a sorted int table. The original
+// binarySearch() and recursiveBinarySearch() branch on every comparison;
+// on a large table each level is a cache miss and, for random keys, a
+// mispredicted branch as well.
+//
+//  - lowerBoundBranchless(): the plain sorted layout, halving with a
+//    conditional add instead of a branch, prefetching both possible next
+//    probes.
+//  - lowerBound() and binarySearch() on a Span: the same halving for any
+//    element type and comparator.
+//  - EytzingerIndex: the table in BFS order, node k with children 2k and
+//    2k + 1. The path is k = 2k + (t[k] < key), and the 16 descendants four
+//    levels down share one cache line, so that line is prefetched each step.
+//  - STreeIndex: an implicit B-tree with 16 keys, one cache line, per node.
+//    A node is searched with one AVX-512 or two AVX2 compares and a popcount,
+//    so a lookup touches log_17 n lines.
+//
+// Each index returns the position in the original sorted table: find()
+// gives the index of key or -1 like binarySearch(), lowerBound() the first
+// index whose value is >= key. With duplicate keys find() returns the first
+// copy, where the original returns whichever copy its probes land on.
+#pragma once
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "counters.hpp"
+#include "simd.hpp"
+#include "span.hpp"
+
+namespace algo {
+
+// Keys per S-tree node, one 64-byte line of ints
+const int STREE_NODE_KEYS = 16;
+// Lookups one thread advances in lockstep in the batch searches
+const int SEARCH_GROUP = 32;
+
+namespace detail {
+
+struct alignas(64) SearchLine {
+    int v[STREE_NODE_KEYS];
+};
+
+} // namespace detail
+
+// First i in [0, n] with arr[i] >= key, arr ascending
+inline int lowerBoundBranchless(const int arr[], int n, int key)
+{
+    if (n <= 0)
+        return 0;
+    const int* base = arr;
+    int len = n;
+    while (len > 1) {
+        int half = len / 2;
+        __builtin_prefetch(base + half / 2 - 1);
+        __builtin_prefetch(base + half + half / 2 - 1);
+        base += base[half - 1] < key ? half : 0;
+        len -= half;
+    }
+    return static_cast<int>(base - arr) + (*base < key);
+}
+
+// binarySearch() without branches: index of key in arr[0..n) or -1
+inline int binarySearch(const int arr[], int n, int key)
+{
+    int i = lowerBoundBranchless(arr, n, key);
+    return i < n && arr[i] == key ? i : -1;
+}
+
+// The same halving for any element type: first i in [0, s.size()] with
+// !comp(s[i], key), s sorted by comp
+template <class T, class Key, class Compare = std::less<>>
+std::size_t lowerBound(Span<T> s, const Key& key, Compare comp = Compare())
+{
+    if (s.empty())
+        return 0;
+    auto less = countComparisons(comp);
+    const T* base = s.data();
+    std::size_t len = s.size();
+    while (len > 1) {
+        std::size_t half = len / 2;
+        base += less(base[half - 1], key) ? half : 0;
+        len -= half;
+    }
+    return static_cast<std::size_t>(base - s.data()) + less(*base, key);
+}
+
+// Index of the first element equivalent to key, or -1
+template <class T, class Key, class Compare = std::less<>>
+std::ptrdiff_t binarySearch(Span<T> s, const Key& key, Compare comp = Compare())
+{
+    auto less = countComparisons(comp);
+    std::size_t i = lowerBound(s, key, less);
+    return i < s.size() && !less(key, s[i]) ? static_cast<std::ptrdiff_t>(i) : -1;
+}
+
+class EytzingerIndex {
+public:
+    EytzingerIndex() = default;
+
+    // sorted[0..n) ascending; the index keeps its own copy
+    EytzingerIndex(const int sorted[], int n) : n_(n > 0 ? n : 0)
+    {
+        // Slot 0 is unused so the root is 1; the lines start at slot 0, so
+        // slots 16k .. 16k + 15 are always one line.
+        lines_.resize(static_cast<std::size_t>(n_) / STREE_NODE_KEYS + 1);
+        rank_.resize(static_cast<std::size_t>(n_) + 1);
+        int next = 0;
+        build(sorted, 1, next);
+    }
+
+    int size() const { return n_; }
+
+    int lowerBound(int key) const
+    {
+        int k = slot(key);
+        return k ? rank_[k] : n_;
+    }
+
+    int find(int key) const
+    {
+        int k = slot(key);
+        return k && keys()[k] == key ? rank_[k] : -1;
+    }
+
+    // find() for keys[0..count), count <= SEARCH_GROUP. The searches go
+    // down one level together, so their cache misses overlap.
+    void findGroup(const int* keys, int count, int* results) const
+    {
+        const int* t = this->keys();
+        const std::size_t last = static_cast<std::size_t>(n_);
+        std::size_t k[SEARCH_GROUP];
+        for (int l = 0; l < count; l++)
+            k[l] = 1;
+        // Every path has a node on each full level; the last level is
+        // partial, so the final step is a select.
+        int full = n_ ? 63 - __builtin_clzll(static_cast<unsigned long long>(last)) : 0;
+        for (int level = 0; level < full; level++) {
+            for (int l = 0; l < count; l++) {
+                std::size_t ahead = STREE_NODE_KEYS * k[l];
+                __builtin_prefetch(t + (ahead <= last ? ahead : 0));
+                k[l] = 2 * k[l] + (t[k[l]] < keys[l]);
+            }
+        }
+        for (int l = 0; l < count; l++) {
+            std::size_t c = k[l] <= last ? k[l] : 0;
+            std::size_t next = 2 * c + (t[c] < keys[l]);
+            std::size_t at = c ? next : k[l];
+            at >>= __builtin_ffsll(static_cast<long long>(~at));
+            results[l] = at && t[at] == keys[l] ? rank_[at] : -1;
+        }
+    }
+
+private:
+    const int* keys() const { return lines_[0].v; }
+
+    // In-order walk of the implicit tree hands out the sorted values
+    void build(const int* sorted, int k, int& next)
+    {
+        if (k > n_)
+            return;
+        build(sorted, 2 * k, next);
+        lines_[k / STREE_NODE_KEYS].v[k % STREE_NODE_KEYS] = sorted[next];
+        rank_[k] = next++;
+        build(sorted, 2 * k + 1, next);
+    }
+
+    // Slot of the first value >= key, 0 if there is none
+    int slot(int key) const
+    {
+        const int* t = keys();
+        const std::size_t last = static_cast<std::size_t>(n_);
+        std::size_t k = 1;
+        while (k <= last) {
+            std::size_t ahead = STREE_NODE_KEYS * k;
+            __builtin_prefetch(t + (ahead <= last ? ahead : 0));
+            k = 2 * k + (t[k] < key);
+        }
+        // The path went right after the answer at every step but one: drop
+        // the trailing ones and the left turn below the answer.
+        k >>= __builtin_ffsll(static_cast<long long>(~k));
+        return static_cast<int>(k);
+    }
+
+    int n_ = 0;
+    std::vector<detail::SearchLine> lines_;
+    std::vector<int> rank_;
+};
+
+namespace detail {
+
+// Number of keys in the node below key, the child to descend into
+inline int nodeRankScalar(const int* node, int key)
+{
+    int r = 0;
+    for (int i = 0; i < STREE_NODE_KEYS; i++)
+        r += node[i] < key;
+    return r;
+}
+
+#ifdef ALGO_X86_SIMD
+__attribute__((target("avx2,popcnt"))) inline int nodeRankAvx2(const int* node, int key)
+{
+    const __m256i k = _mm256_set1_epi32(key);
+    __m256i lo = _mm256_cmpgt_epi32(k, _mm256_load_si256(reinterpret_cast<const __m256i*>(node)));
+    __m256i hi = _mm256_cmpgt_epi32(k, _mm256_load_si256(reinterpret_cast<const __m256i*>(node + 8)));
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(lo))) |
+                    static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(hi))) << 8;
+    return __builtin_popcount(mask);
+}
+
+__attribute__((target("avx512f,popcnt"))) inline int nodeRankAvx512(const int* node, int key)
+{
+    __mmask16 less = _mm512_cmplt_epi32_mask(_mm512_load_si512(node), _mm512_set1_epi32(key));
+    return __builtin_popcount(less);
+}
+#endif
+
+enum class NodeKernel { Scalar, Avx2, Avx512 };
+
+inline NodeKernel bestNodeKernel()
+{
+#ifdef ALGO_X86_SIMD
+    static const NodeKernel best = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("popcnt")
+                                       ? NodeKernel::Avx512
+                                   : __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")
+                                       ? NodeKernel::Avx2
+                                       : NodeKernel::Scalar;
+    return best;
+#else
+    return NodeKernel::Scalar;
+#endif
+}
+
+} // namespace detail
+
+class STreeIndex {
+public:
+    STreeIndex() = default;
+
+    // sorted[0..n) ascending; the index keeps its own copy
+    STreeIndex(const int sorted[], int n) : n_(n > 0 ? n : 0), kernel_(detail::bestNodeKernel())
+    {
+        nodes_ = (static_cast<std::size_t>(n_) + STREE_NODE_KEYS - 1) / STREE_NODE_KEYS;
+        keys_.resize(nodes_);
+        rank_.resize(nodes_);
+        int next = 0;
+        build(sorted, 0, next);
+    }
+
+    int size() const { return n_; }
+
+    int lowerBound(int key) const
+    {
+        const int* at = slot(key);
+        return at ? rankOf(at) : n_;
+    }
+
+    int find(int key) const
+    {
+        const int* at = slot(key);
+        if (!at || *at != key)
+            return -1;
+        int r = rankOf(at);
+        return r < n_ ? r : -1;
+    }
+
+private:
+    static std::size_t child(std::size_t k, int i) { return k * (STREE_NODE_KEYS + 1) + i + 1; }
+
+    int rankOf(const int* at) const
+    {
+        std::size_t pos = static_cast<std::size_t>(at - keys_[0].v);
+        return rank_[pos / STREE_NODE_KEYS].v[pos % STREE_NODE_KEYS];
+    }
+
+    // In-order walk, key i of a node between its children i and i + 1. The
+    // last node is padded with INT_MAX of rank n, after every real value.
+    void build(const int* sorted, std::size_t k, int& next)
+    {
+        if (k >= nodes_)
+            return;
+        for (int i = 0; i < STREE_NODE_KEYS; i++) {
+            build(sorted, child(k, i), next);
+            if (next < n_) {
+                keys_[k].v[i] = sorted[next];
+                rank_[k].v[i] = next++;
+            } else {
+                keys_[k].v[i] = INT_MAX;
+                rank_[k].v[i] = n_;
+            }
+        }
+        build(sorted, child(k, STREE_NODE_KEYS), next);
+    }
+
+    const int* slot(int key) const
+    {
+        switch (kernel_) {
+#ifdef ALGO_X86_SIMD
+        case detail::NodeKernel::Avx512:
+            return slotAvx512(key);
+        case detail::NodeKernel::Avx2:
+            return slotAvx2(key);
+#endif
+        default:
+            return search<detail::NodeKernel::Scalar>(key);
+        }
+    }
+
+    // Slot of the first value >= key, nullptr if there is none
+    template <detail::NodeKernel Kernel>
+    __attribute__((always_inline)) const int* search(int key) const
+    {
+        const int* best = nullptr;
+        std::size_t k = 0;
+        while (k < nodes_) {
+            const int* node = keys_[k].v;
+            int i;
+#ifdef ALGO_X86_SIMD
+            if constexpr (Kernel == detail::NodeKernel::Avx512)
+                i = detail::nodeRankAvx512(node, key);
+            else if constexpr (Kernel == detail::NodeKernel::Avx2)
+                i = detail::nodeRankAvx2(node, key);
+            else
+#endif
+                i = detail::nodeRankScalar(node, key);
+            if (i < STREE_NODE_KEYS)
+                best = node + i;
+            k = child(k, i);
+        }
+        return best;
+    }
+
+#ifdef ALGO_X86_SIMD
+    __attribute__((target("avx2,popcnt"))) const int* slotAvx2(int key) const
+    {
+        return search<detail::NodeKernel::Avx2>(key);
+    }
+    __attribute__((target("avx512f,popcnt"))) const int* slotAvx512(int key) const
+    {
+        return search<detail::NodeKernel::Avx512>(key);
+    }
+#endif
+
+    int n_ = 0;
+    std::size_t nodes_ = 0;
+    detail::NodeKernel kernel_ = detail::NodeKernel::Scalar;
+    std::vector<detail::SearchLine> keys_, rank_;
+};
+
+} // namespace algo
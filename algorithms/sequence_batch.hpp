@@ -0,0 +1,319 @@
+// Batched LCS and edit distance over many short string pairs. Instead of a
+// fresh stack table and a printf per pair, the batch API fills a
+// caller-provided score array (and optionally alignment buffers) with no
+// I/O, reusing a thread-local DP arena per worker.
+//
+// Short pairs are grouped BATCH_LANES at a time, sorted by length so a
+// group pads little, and solved together: every DP cell is a vector of
+// 16-bit values, one lane per pair. Pairs longer than
+// BATCH_LANE_MAX_LENGTH fall back to one pair at a time. On x86-64 the
+// lane kernel is also compiled for AVX2 and picked at runtime, so a DP
+// cell is a single 256-bit register.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "counters.hpp"
+#include "lcs.hpp"
+#include "radix_sort.hpp"
+#include "simd.hpp"
+#include "thread_pool.hpp"
+
+namespace algo {
+
+enum class PairMetric { Lcs, EditDistance };
+
+struct SequencePair {
+    const char* a;
+    int m;
+    const char* b;
+    int n;
+};
+
+// Optional alignment output. Pair p writes at most m + n operations to
+// ops + offsets[p] and its operation count to lengths[p]:
+// 'M' match, 'X' substitution (edit distance only), 'D' a[i] deleted,
+// 'I' b[j] inserted. alignmentOffsets() lays the buffer out.
+struct BatchAlignments {
+    char* ops;
+    const std::size_t* offsets;
+    int* lengths;
+};
+
+const int BATCH_LANES = 16;
+// Scores and lane indices stay well inside 16 bits.
+const int BATCH_LANE_MAX_LENGTH = 4096;
+
+// offsets[p] for every pair; returns the size of the ops buffer.
+inline std::size_t alignmentOffsets(const SequencePair* pairs, std::size_t count, std::size_t* offsets)
+{
+    std::size_t total = 0;
+    for (std::size_t p = 0; p < count; p++) {
+        offsets[p] = total;
+        total += static_cast<std::size_t>(pairs[p].m) + pairs[p].n;
+    }
+    return total;
+}
+
+namespace detail {
+
+typedef std::uint16_t LaneVec __attribute__((vector_size(2 * BATCH_LANES)));
+
+// Outside AVX code GCC only aligns a 32-byte vector to 16 bytes, so the
+// arena rows carry the alignment the AVX2 kernel's loads assume.
+struct alignas(2 * BATCH_LANES) LaneCell {
+    LaneVec v;
+};
+
+// Grows only; one per thread, shared by every batch call on it.
+struct SequenceArena {
+    std::vector<LaneCell> a, b, prev, cur;
+    std::vector<int> table;
+};
+
+inline LaneVec* laneRow(std::vector<LaneCell>& cells, int n)
+{
+    cells.resize(std::max(n, 1));
+    return &cells[0].v;
+}
+
+inline SequenceArena& sequenceArena()
+{
+    thread_local SequenceArena arena;
+    return arena;
+}
+
+// Scores of up to BATCH_LANES pairs, pairs[order[0 .. lanes)]. Padding
+// characters differ between a and b and from every byte, so they never
+// match.
+template <PairMetric Metric>
+__attribute__((always_inline)) inline void laneScoresBody(const SequencePair* pairs, const std::uint32_t* order,
+                                                          int lanes, int* scores, SequenceArena& arena)
+{
+    const bool edit = Metric == PairMetric::EditDistance;
+    int maxM = 0, maxN = 0;
+    for (int l = 0; l < lanes; l++) {
+        maxM = std::max(maxM, pairs[order[l]].m);
+        maxN = std::max(maxN, pairs[order[l]].n);
+    }
+    const LaneVec padA = LaneVec{} + 0x100, padB = LaneVec{} + 0x101;
+    LaneVec* a = laneRow(arena.a, maxM);
+    LaneVec* b = laneRow(arena.b, maxN);
+    std::fill(a, a + maxM, padA);
+    std::fill(b, b + maxN, padB);
+    for (int l = 0; l < lanes; l++) {
+        const SequencePair& p = pairs[order[l]];
+        for (int i = 0; i < p.m; i++)
+            a[i][l] = static_cast<unsigned char>(p.a[i]);
+        for (int j = 0; j < p.n; j++)
+            b[j][l] = static_cast<unsigned char>(p.b[j]);
+    }
+
+    LaneVec* prev = laneRow(arena.prev, maxN + 1);
+    LaneVec* cur = laneRow(arena.cur, maxN + 1);
+    const LaneVec one = LaneVec{} + 1;
+    for (int j = 0; j <= maxN; j++)
+        prev[j] = LaneVec{} + static_cast<std::uint16_t>(edit ? j : 0);
+
+    auto collect = [&](int i, const LaneVec* row) {
+        for (int l = 0; l < lanes; l++)
+            if (pairs[order[l]].m == i)
+                scores[order[l]] = row[pairs[order[l]].n][l];
+    };
+    collect(0, prev);
+    for (int i = 1; i <= maxM; i++) {
+        const LaneVec x = a[i - 1];
+        cur[0] = LaneVec{} + static_cast<std::uint16_t>(edit ? i : 0);
+        for (int j = 1; j <= maxN; j++) {
+            LaneVec match = reinterpret_cast<LaneVec>(x == b[j - 1]) & one;
+            if (edit) {
+                LaneVec gap = (prev[j] < cur[j - 1] ? prev[j] : cur[j - 1]) + one;
+                LaneVec diag = prev[j - 1] + (match ^ one);
+                cur[j] = gap < diag ? gap : diag;
+            } else {
+                LaneVec gap = prev[j] > cur[j - 1] ? prev[j] : cur[j - 1];
+                LaneVec diag = prev[j - 1] + match;
+                cur[j] = gap > diag ? gap : diag;
+            }
+        }
+        collect(i, cur);
+        std::swap(prev, cur);
+    }
+    // Padding cells of the shorter pairs included
+    ALGO_COUNT(cells, static_cast<std::uint64_t>(maxM) * maxN * lanes);
+}
+
+#ifdef ALGO_X86_SIMD
+template <PairMetric Metric>
+__attribute__((target("avx2"))) void laneScoresAvx2(const SequencePair* pairs, const std::uint32_t* order, int lanes,
+                                                    int* scores, SequenceArena& arena)
+{
+    laneScoresBody<Metric>(pairs, order, lanes, scores, arena);
+}
+#endif
+
+template <PairMetric Metric>
+void laneScores(const SequencePair* pairs, const std::uint32_t* order, int lanes, int* scores, SequenceArena& arena)
+{
+#ifdef ALGO_X86_SIMD
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx2)
+        return laneScoresAvx2<Metric>(pairs, order, lanes, scores, arena);
+#endif
+    laneScoresBody<Metric>(pairs, order, lanes, scores, arena);
+}
+
+// One pair, two rows of the arena, score only
+template <PairMetric Metric>
+int pairScore(const SequencePair& p, SequenceArena& arena)
+{
+    if (Metric == PairMetric::Lcs)
+        return lcsLength(p.a, p.b, p.m, p.n);
+    std::vector<int>& row = arena.table;
+    row.resize(static_cast<std::size_t>(p.n) + 1);
+    for (int j = 0; j <= p.n; j++)
+        row[j] = j;
+    ALGO_COUNT(cells, static_cast<std::uint64_t>(p.m) * p.n);
+    for (int i = 1; i <= p.m; i++) {
+        int diag = row[0];
+        row[0] = i;
+        for (int j = 1; j <= p.n; j++) {
+            int up = row[j];
+            row[j] = std::min(std::min(up, row[j - 1]) + 1, diag + (p.a[i - 1] != p.b[j - 1]));
+            diag = up;
+        }
+    }
+    return row[p.n];
+}
+
+// One pair with the full table of the arena and a traceback into ops.
+// Ties prefer a match or substitution, then a deletion; the LCS traceback
+// is the one of the original lcs().
+template <PairMetric Metric>
+int pairAlignment(const SequencePair& p, SequenceArena& arena, char* ops, int& length)
+{
+    const bool edit = Metric == PairMetric::EditDistance;
+    const int m = p.m, n = p.n;
+    const std::size_t stride = static_cast<std::size_t>(n) + 1;
+    std::vector<int>& L = arena.table;
+    L.resize((static_cast<std::size_t>(m) + 1) * stride);
+    auto at = [&](int i, int j) -> int& { return L[static_cast<std::size_t>(i) * stride + j]; };
+    for (int j = 0; j <= n; j++)
+        at(0, j) = edit ? j : 0;
+    ALGO_COUNT(cells, static_cast<std::uint64_t>(m) * n);
+    for (int i = 1; i <= m; i++) {
+        at(i, 0) = edit ? i : 0;
+        for (int j = 1; j <= n; j++) {
+            bool same = p.a[i - 1] == p.b[j - 1];
+            if (edit)
+                at(i, j) = std::min(std::min(at(i - 1, j), at(i, j - 1)) + 1, at(i - 1, j - 1) + !same);
+            else
+                at(i, j) = same ? at(i - 1, j - 1) + 1 : std::max(at(i - 1, j), at(i, j - 1));
+        }
+    }
+
+    int i = m, j = n, k = 0;
+    while (i > 0 || j > 0) {
+        bool same = i > 0 && j > 0 && p.a[i - 1] == p.b[j - 1];
+        if (edit) {
+            if (i > 0 && j > 0 && at(i, j) == at(i - 1, j - 1) + !same) {
+                ops[k++] = same ? 'M' : 'X';
+                i--;
+                j--;
+            } else if (i > 0 && at(i, j) == at(i - 1, j) + 1) {
+                ops[k++] = 'D';
+                i--;
+            } else {
+                ops[k++] = 'I';
+                j--;
+            }
+        } else if (same) {
+            ops[k++] = 'M';
+            i--;
+            j--;
+        } else if (j == 0 || (i > 0 && at(i - 1, j) > at(i, j - 1))) {
+            ops[k++] = 'D';
+            i--;
+        } else {
+            ops[k++] = 'I';
+            j--;
+        }
+    }
+    std::reverse(ops, ops + k);
+    length = k;
+    return at(m, n);
+}
+
+template <PairMetric Metric>
+void compareBatch(const SequencePair* pairs, std::size_t count, int* scores, ThreadPool* pool,
+                  const BatchAlignments* align)
+{
+    if (count == 0)
+        return;
+    if (align) {
+        auto work = [&](unsigned, std::size_t b, std::size_t e) {
+            SequenceArena& arena = sequenceArena();
+            for (std::size_t p = b; p < e; p++)
+                scores[p] = pairAlignment<Metric>(pairs[p], arena, align->ops + align->offsets[p], align->lengths[p]);
+        };
+        if (pool)
+            pool->parallelFor(count, 0, work);
+        else
+            work(0, 0, count);
+        return;
+    }
+
+    // Long pairs sort last; groups are formed from the short prefix.
+    std::vector<std::uint32_t> key(count);
+    for (std::size_t p = 0; p < count; p++) {
+        int len = std::max(pairs[p].m, pairs[p].n);
+        key[p] = static_cast<std::uint32_t>(len > BATCH_LANE_MAX_LENGTH ? BATCH_LANE_MAX_LENGTH + 1 : len);
+    }
+    std::vector<std::uint32_t> order = radixSortIndices(key.data(), count);
+    std::size_t shortCount = 0;
+    while (shortCount < count && key[order[shortCount]] <= static_cast<std::uint32_t>(BATCH_LANE_MAX_LENGTH))
+        shortCount++;
+    std::size_t groups = (shortCount + BATCH_LANES - 1) / BATCH_LANES;
+
+    auto work = [&](unsigned, std::size_t b, std::size_t e) {
+        SequenceArena& arena = sequenceArena();
+        for (std::size_t t = b; t < e; t++) {
+            if (t < groups) {
+                std::size_t first = t * BATCH_LANES;
+                int lanes = static_cast<int>(std::min<std::size_t>(BATCH_LANES, shortCount - first));
+                laneScores<Metric>(pairs, order.data() + first, lanes, scores, arena);
+            } else {
+                std::uint32_t p = order[shortCount + (t - groups)];
+                scores[p] = pairScore<Metric>(pairs[p], arena);
+            }
+        }
+    };
+    std::size_t tasks = groups + (count - shortCount);
+    if (pool)
+        pool->parallelFor(tasks, 0, work);
+    else
+        work(0, 0, tasks);
+}
+
+} // namespace detail
+
+// lengths[p] = LCS length of pair p. With align, also one alignment per
+// pair from the full table.
+inline void lcsBatch(const SequencePair* pairs, std::size_t count, int* lengths, ThreadPool* pool = nullptr,
+                     const BatchAlignments* align = nullptr)
+{
+    detail::compareBatch<PairMetric::Lcs>(pairs, count, lengths, pool, align);
+}
+
+// distances[p] = Levenshtein distance of pair p (unit insert, delete and
+// substitute costs).
+inline void editDistanceBatch(const SequencePair* pairs, std::size_t count, int* distances, ThreadPool* pool = nullptr,
+                              const BatchAlignments* align = nullptr)
+{
+    detail::compareBatch<PairMetric::EditDistance>(pairs, count, distances, pool, align);
+}
+
+} // namespace algo
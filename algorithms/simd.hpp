@@ -0,0 +1,13 @@
+// x86 SIMD detection shared by the kernels with AVX2 and AVX-512 paths.
+// ALGO_X86_SIMD is defined on x86-64 with GCC or Clang, which compile each
+// wide kernel with a target attribute so that one binary carries them all;
+// the callers pick one at runtime with __builtin_cpu_supports(). Other
+// compilers and targets get the scalar kernels only.
+#pragma once
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(ALGO_X86_SIMD)
+#define ALGO_X86_SIMD 1
+#endif
+#ifdef ALGO_X86_SIMD
+#include <immintrin.h>
+#endif
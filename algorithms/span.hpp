@@ -0,0 +1,77 @@
+// Non-owning view of a contiguous array, the C++17 stand-in for std::span.
+// The kernels take a pointer and a length; their Span overloads accept a
+// vector, std::array, string or C array through span(), with the element
+// type and comparator deduced:
+//
+//     algo::quickSort(algo::span(names), byLength);
+//
+// Span<T> converts to Span<const T>, so read-only kernels take either.
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace algo {
+
+template <class T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = typename std::remove_cv<T>::type;
+    using iterator = T*;
+
+    constexpr Span() = default;
+    constexpr Span(T* data, std::size_t size) : data_(data), size_(size) {}
+
+    template <std::size_t N>
+    constexpr Span(T (&array)[N]) : data_(array), size_(N)
+    {
+    }
+
+    // Any container with data() and size() over T, or over U converting to T
+    template <class Container,
+              class = typename std::enable_if<std::is_convertible<
+                  typename std::remove_pointer<decltype(std::data(std::declval<Container&>()))>::type (*)[],
+                  T (*)[]>::value>::type>
+    constexpr Span(Container& c) : data_(std::data(c)), size_(std::size(c))
+    {
+    }
+
+    template <class U, class = typename std::enable_if<std::is_convertible<U (*)[], T (*)[]>::value>::type>
+    constexpr Span(const Span<U>& other) : data_(other.data()), size_(other.size())
+    {
+    }
+
+    constexpr T* data() const { return data_; }
+    constexpr std::size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+    constexpr T* begin() const { return data_; }
+    constexpr T* end() const { return data_ + size_; }
+    constexpr T& operator[](std::size_t i) const { return data_[i]; }
+
+    // [offset, offset + count), clipped to the end
+    constexpr Span subspan(std::size_t offset, std::size_t count = std::size_t(-1)) const
+    {
+        offset = offset < size_ ? offset : size_;
+        return {data_ + offset, count < size_ - offset ? count : size_ - offset};
+    }
+
+private:
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+template <class T>
+constexpr Span<T> span(T* data, std::size_t size)
+{
+    return {data, size};
+}
+
+template <class Container>
+constexpr auto span(Container& c) -> Span<typename std::remove_pointer<decltype(std::data(c))>::type>
+{
+    return {std::data(c), std::size(c)};
+}
+
+} // namespace algo
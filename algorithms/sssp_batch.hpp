@@ -0,0 +1,143 @@
+// Batched shortest-path queries against one prepared graph.
+// The CSR graph is built once; each worker keeps a ShortestPathWorkspace
+// whose heap, distance and pred arrays are reused between queries. A
+// generation counter marks which slots belong to the current query, so
+// starting a new one costs O(1) instead of clearing n entries.
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "counters.hpp"
+#include "dijkstra.hpp"
+#include "graph.hpp"
+#include "thread_pool.hpp"
+
+namespace algo {
+
+class ShortestPathWorkspace {
+public:
+    explicit ShortestPathWorkspace(int n = 0) { reset(n); }
+
+    void reset(int n)
+    {
+        heap_.reset(n);
+        distance_.assign(n, INFINITY_DIST);
+        pred_.assign(n, 0);
+        stamp_.assign(n, 0);
+        generation_ = 0;
+        startnode_ = 0;
+    }
+
+    // Run Dijkstra from startnode; results stay valid until the next run().
+    // Same relaxation order and tie-break as dijkstra().
+    void run(CsrView g, int startnode)
+    {
+        if (heap_.capacity() != g.n)
+            reset(g.n);
+        if (++generation_ == 0) {
+            std::fill(stamp_.begin(), stamp_.end(), 0u);
+            generation_ = 1;
+        }
+        heap_.clear();
+        startnode_ = startnode;
+
+        touch(startnode);
+        distance_[startnode] = 0;
+        heap_.push(startnode, 0);
+
+        while (!heap_.empty()) {
+            int nextnode = heap_.pop();
+            long long mindistance = distance_[nextnode];
+            ALGO_COUNT(relaxations, g.offsets[nextnode + 1] - g.offsets[nextnode]);
+            for (std::int64_t k = g.offsets[nextnode]; k < g.offsets[nextnode + 1]; k++) {
+                int i = g.adj[k];
+                long long d = mindistance + g.weight[k];
+                touch(i);
+                if (d < distance_[i]) {
+                    distance_[i] = d;
+                    pred_[i] = nextnode;
+                    heap_.push(i, d);
+                }
+            }
+        }
+    }
+
+    long long distance(int v) const { return stamp_[v] == generation_ ? distance_[v] : INFINITY_DIST; }
+    int pred(int v) const { return stamp_[v] == generation_ ? pred_[v] : startnode_; }
+
+    // Copy the last query's results into rows of length n.
+    void copyOut(long long* distance, int* pred) const
+    {
+        const int n = static_cast<int>(stamp_.size());
+        for (int v = 0; v < n; v++) {
+            bool live = stamp_[v] == generation_;
+            distance[v] = live ? distance_[v] : INFINITY_DIST;
+            if (pred)
+                pred[v] = live ? pred_[v] : startnode_;
+        }
+    }
+
+private:
+    void touch(int v)
+    {
+        if (stamp_[v] != generation_) {
+            stamp_[v] = generation_;
+            distance_[v] = INFINITY_DIST;
+            pred_[v] = startnode_;
+        }
+    }
+
+    IndexedMinHeap heap_;
+    std::vector<long long> distance_;
+    std::vector<int> pred_;
+    std::vector<unsigned> stamp_;
+    unsigned generation_ = 0;
+    int startnode_ = 0;
+};
+
+// Results of a batch, one row of n entries per start node:
+// distance[q * n + v] is the distance from sources[q] to v.
+struct BatchShortestPaths {
+    int n = 0;
+    std::vector<long long> distance;
+    std::vector<int> pred; // empty unless requested
+
+    const long long* distanceRow(std::size_t q) const { return distance.data() + q * n; }
+    const int* predRow(std::size_t q) const { return pred.data() + q * n; }
+};
+
+// Answer every start node in sources. With a pool, queries are spread over
+// its workers, each with its own workspace; without one they run inline.
+inline BatchShortestPaths dijkstraBatch(CsrView g, const std::vector<int>& sources,
+                                        bool withPred = true, ThreadPool* pool = nullptr)
+{
+    BatchShortestPaths out;
+    out.n = g.n;
+    const std::size_t n = static_cast<std::size_t>(g.n);
+    out.distance.resize(sources.size() * n);
+    if (withPred)
+        out.pred.resize(sources.size() * n);
+
+    auto answer = [&](ShortestPathWorkspace& ws, std::size_t q) {
+        ws.run(g, sources[q]);
+        ws.copyOut(out.distance.data() + q * n, withPred ? out.pred.data() + q * n : nullptr);
+    };
+
+    if (!pool || pool->size() == 1) {
+        ShortestPathWorkspace ws(g.n);
+        for (std::size_t q = 0; q < sources.size(); q++)
+            answer(ws, q);
+        return out;
+    }
+
+    std::vector<ShortestPathWorkspace> workspaces(pool->size());
+    pool->parallelFor(sources.size(), 1, [&](unsigned worker, std::size_t b, std::size_t e) {
+        for (std::size_t q = b; q < e; q++)
+            answer(workspaces[worker], q);
+    });
+    return out;
+}
+
+} // namespace algo
@@ -0,0 +1,236 @@
+// Subset sum. The original findSubset() tries both branches for every
+// element, only pruning once the running sum passes the target, and prints
+// every subset it finds. Three modes for non-negative elements:
+//  - subsetSumReachable(): bitset DP, reach |= reach << x, feasibility in
+//    O(n * target / 64).
+//  - subsetSumMeetInMiddle(): counts the subsets (and returns one) for
+//    targets too large for the bitset, n up to about 45. Each half's 2^(n/2)
+//    sums are generated already sorted and matched with two pointers.
+//  - findSubsets(): enumerates every subset like the original, but on the
+//    sorted input, stopping a branch as soon as the next element overshoots
+//    or the remaining suffix cannot reach the target. Zero elements extend
+//    a matching subset, so every subset of indices is counted, as in
+//    subsetSumMeetInMiddle(). Subsets go to a callback instead of stdout. On a TaskPool the branches with more than
+//    SUBSET_TASK_MIN_ELEMENTS elements left to choose from are tasks.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bitset.hpp"
+#include "counters.hpp"
+#include "task_pool.hpp"
+
+namespace algo {
+
+// Meet in the middle keeps 2^ceil(n / 2) sums per half.
+const int SUBSET_SUM_MITM_MAX = 46;
+
+// A findSubsets() branch with at most this many elements left is searched
+// in one task
+const int SUBSET_TASK_MIN_ELEMENTS = 16;
+
+// Bit s is set when some subset of set[0 .. n) sums to s, s = 0 .. target.
+inline DynamicBitset subsetSums(const int set[], int n, int target)
+{
+    DynamicBitset reach(target >= 0 ? static_cast<std::size_t>(target) + 1 : 0);
+    if (target < 0)
+        return reach;
+    reach.set(0);
+    for (int i = 0; i < n; i++)
+        if (set[i] <= target) {
+            reach.orShiftedLeft(static_cast<std::size_t>(set[i]));
+            ALGO_COUNT(cells, target + 1);
+        }
+    return reach;
+}
+
+inline bool subsetSumReachable(const int set[], int n, int target)
+{
+    return target >= 0 && subsetSums(set, n, target).test(static_cast<std::size_t>(target));
+}
+
+namespace detail {
+
+// All 2^n subset sums of set[0 .. n) in ascending order, with the subset
+// of each as a bit mask: merging the sorted list with itself shifted by
+// the next element keeps it sorted, O(2^n) in total.
+inline void sortedSubsetSums(const long long* set, int n, std::vector<long long>& sums,
+                             std::vector<std::uint32_t>& masks)
+{
+    sums.assign(1, 0);
+    masks.assign(1, 0);
+    std::vector<long long> nextSums;
+    std::vector<std::uint32_t> nextMasks;
+    for (int i = 0; i < n; i++) {
+        const std::size_t k = sums.size();
+        const long long x = set[i];
+        const std::uint32_t bit = std::uint32_t(1) << i;
+        nextSums.resize(2 * k);
+        nextMasks.resize(2 * k);
+        std::size_t a = 0, b = 0, out = 0;
+        while (a < k || b < k) {
+            if (b == k || (a < k && sums[a] <= sums[b] + x)) {
+                nextSums[out] = sums[a];
+                nextMasks[out++] = masks[a++];
+            } else {
+                nextSums[out] = sums[b] + x;
+                nextMasks[out++] = masks[b++] | bit;
+            }
+        }
+        sums.swap(nextSums);
+        masks.swap(nextMasks);
+    }
+}
+
+template <class Callback>
+void findSubsetsRec(const int* sorted, const long long* suffix, int n, int i, int target, long long currentSum,
+                    std::vector<int>& subset, long long& found, Callback& callback)
+{
+    ALGO_DEPTH_SCOPE();
+    // A match still grows by the zeros that may follow it; the first
+    // positive element then overshoots
+    if (currentSum == target) {
+        found++;
+        callback(static_cast<const int*>(subset.data()), static_cast<int>(subset.size()));
+    }
+    for (; i < n; i++) {
+        // Ascending input: if this element overshoots, so does every later one
+        if (currentSum + sorted[i] > target)
+            return;
+        if (currentSum + suffix[i] < target)
+            return;
+        subset.push_back(sorted[i]);
+        findSubsetsRec(sorted, suffix, n, i + 1, target, currentSum + sorted[i], subset, found, callback);
+        subset.pop_back();
+    }
+}
+
+// findSubsetsRec() with the candidates for the next element as tasks, each
+// with its own copy of subset; returns the subsets found below. A branch
+// that already matches only has zeros left to add and is searched in one
+// task.
+template <class Callback>
+long long findSubsetsTasks(TaskPool& pool, const int* sorted, const long long* suffix, int n, int i, int target,
+                           long long currentSum, const std::vector<int>& subset, Callback& callback)
+{
+    if (n - i <= SUBSET_TASK_MIN_ELEMENTS || currentSum == target) {
+        std::vector<int> branch = subset;
+        long long found = 0;
+        findSubsetsRec(sorted, suffix, n, i, target, currentSum, branch, found, callback);
+        return found;
+    }
+    // The candidates run up to the first the loop above would stop at
+    int end = i;
+    while (end < n && currentSum + sorted[end] <= target && currentSum + suffix[end] >= target)
+        end++;
+    std::vector<long long> found(end - i);
+    pool.parallelFor(end - i, 1, [&](unsigned, std::size_t b, std::size_t e) {
+        for (std::size_t k = b; k < e; k++) {
+            const int next = i + static_cast<int>(k);
+            std::vector<int> branch = subset;
+            branch.push_back(sorted[next]);
+            found[k] = findSubsetsTasks(pool, sorted, suffix, n, next + 1, target, currentSum + sorted[next], branch,
+                                        callback);
+        }
+    });
+    long long total = 0;
+    for (long long f : found)
+        total += f;
+    return total;
+}
+
+// set sorted ascending, and suffix[i] the sum of sorted[i..]
+inline void sortWithSuffix(const int set[], int n, std::vector<int>& sorted, std::vector<long long>& suffix)
+{
+    sorted.assign(set, set + std::max(n, 0));
+    std::sort(sorted.begin(), sorted.end());
+    suffix.assign(sorted.size() + 1, 0);
+    for (std::size_t i = sorted.size(); i-- > 0;)
+        suffix[i] = suffix[i + 1] + sorted[i];
+}
+
+} // namespace detail
+
+struct SubsetSumCount {
+    long long count = 0;  // subsets of indices that sum to target
+    std::vector<int> one; // indices of one of them, ascending, if count > 0
+};
+
+inline SubsetSumCount subsetSumMeetInMiddle(const long long set[], int n, long long target)
+{
+    SubsetSumCount result;
+    if (n < 0 || n > SUBSET_SUM_MITM_MAX)
+        return result;
+    const int half = n / 2;
+    std::vector<long long> left, right;
+    std::vector<std::uint32_t> leftMask, rightMask;
+    detail::sortedSubsetSums(set, half, left, leftMask);
+    detail::sortedSubsetSums(set + half, n - half, right, rightMask);
+
+    // left ascending, right descending; equal runs pair up with each other
+    std::size_t a = 0, b = right.size();
+    while (a < left.size() && b > 0) {
+        long long s = left[a] + right[b - 1];
+        if (s < target) {
+            a++;
+        } else if (s > target) {
+            b--;
+        } else {
+            std::size_t a1 = a, b1 = b;
+            while (a1 < left.size() && left[a1] == left[a])
+                a1++;
+            while (b1 > 0 && right[b1 - 1] == right[b - 1])
+                b1--;
+            if (result.count == 0) {
+                for (int i = 0; i < half; i++)
+                    if (leftMask[a] >> i & 1)
+                        result.one.push_back(i);
+                for (int i = 0; i < n - half; i++)
+                    if (rightMask[b - 1] >> i & 1)
+                        result.one.push_back(half + i);
+            }
+            result.count += static_cast<long long>(a1 - a) * static_cast<long long>(b - b1);
+            a = a1;
+            b = b1;
+        }
+    }
+    return result;
+}
+
+// Calls callback(const int* subset, int size) for every subset of indices
+// summing to target, the values in ascending order, and returns how many
+// there were. For positive elements these are the subsets the original
+// prints, in a different order.
+template <class Callback>
+long long findSubsets(const int set[], int n, int target, Callback callback)
+{
+    std::vector<int> sorted;
+    std::vector<long long> suffix;
+    detail::sortWithSuffix(set, n, sorted, suffix);
+    std::vector<int> subset;
+    long long found = 0;
+    detail::findSubsetsRec(sorted.data(), suffix.data(), static_cast<int>(sorted.size()), 0, target, 0, subset, found,
+                           callback);
+    return found;
+}
+
+// findSubsets() on a TaskPool. callback may run on several workers at
+// once, and the subsets come in no fixed order.
+template <class Callback>
+long long findSubsets(const int set[], int n, int target, TaskPool& pool, Callback callback)
+{
+    std::vector<int> sorted;
+    std::vector<long long> suffix;
+    detail::sortWithSuffix(set, n, sorted, suffix);
+    long long found = 0;
+    pool.run([&] {
+        found = detail::findSubsetsTasks(pool, sorted.data(), suffix.data(), static_cast<int>(sorted.size()), 0,
+                                         target, 0, std::vector<int>(), callback);
+    });
+    return found;
+}
+
+} // namespace algo
@@ -0,0 +1,448 @@
+// Work-stealing fork/join pool for the recursive parallel modes: the quick
+// and merge sorts, minMax(), the hull's chain merge and the N-Queens and
+// subset-sum searches. ThreadPool runs one flat loop at a time and must not
+// be re-entered. Here any task may fork again, so divide and conquer steps
+// and nested parallel calls share one set of workers instead of each
+// starting threads of its own.
+//  - invoke(a, b) runs a and b, possibly in parallel. b goes on the calling
+//    worker's deque and a runs at once; b is then popped back and run,
+//    unless a thief took it, in which case the worker steals other tasks
+//    until b is done. Tasks live on the forking frame, so a fork allocates
+//    nothing.
+//  - Every worker owns a Chase-Lev deque, in the C11 form of Le, Pop, Cohen
+//    and Zappa Nardelli. The owner pushes and pops the bottom without a
+//    lock; thieves take the top, the oldest and largest task, with one CAS.
+//    The ring holds TASK_DEQUE_CAPACITY tasks; a fork that finds it full
+//    runs b inline, which takes a recursion that deep.
+//  - Each call site has its own sequential cutoff (QUICK_SORT_TASK_CUTOFF,
+//    NQUEENS_TASK_DEPTH, ...), below which it calls the sequential kernel
+//    and forks no more.
+//  - Workers are not pinned by default. With Pinning::Numa on Linux, worker
+//    w is pinned to the w-th CPU the process may run on, counted node by
+//    node, and thieves try the workers of their own node before the others.
+//    The caller takes part as worker 0 and is left where it is.
+// Between run()s the workers sleep; during one, idle workers keep stealing
+// and yield the CPU between attempts. defaultTaskPool() is one pool for the
+// whole process.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#endif
+
+#include "thread_pool.hpp"
+
+namespace algo {
+
+const std::size_t TASK_DEQUE_CAPACITY = 1 << 12;
+
+// Failed steal rounds between yields of an idle worker
+const int TASK_SPINS_BEFORE_YIELD = 16;
+
+enum class Pinning { None, Numa };
+
+namespace detail {
+
+struct Task {
+    void (*execute)(Task*);
+    std::atomic<bool> done{false};
+};
+
+template <class F>
+struct FunctionTask : Task {
+    F& fn;
+
+    explicit FunctionTask(F& f) : fn(f)
+    {
+        execute = [](Task* t) { static_cast<FunctionTask*>(t)->fn(); };
+    }
+};
+
+// Fixed ring; top and bottom only grow. Every access is atomic, and each
+// bottom store releases the tasks pushed before it to the thieves.
+class TaskDeque {
+public:
+    // False when full
+    bool push(Task* task)
+    {
+        const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        const std::int64_t t = top_.load(std::memory_order_acquire);
+        if (b - t >= static_cast<std::int64_t>(TASK_DEQUE_CAPACITY))
+            return false;
+        slots_[b & MASK].store(task, std::memory_order_relaxed);
+        bottom_.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    // The newest task, or null when thieves took them all
+    Task* pop()
+    {
+        const std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(b, std::memory_order_seq_cst);
+        std::int64_t t = top_.load(std::memory_order_seq_cst);
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_release);
+            return nullptr;
+        }
+        Task* task = slots_[b & MASK].load(std::memory_order_relaxed);
+        if (t == b) {
+            // The last task: race the thieves for it
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                task = nullptr;
+            bottom_.store(b + 1, std::memory_order_release);
+        }
+        return task;
+    }
+
+    // The oldest task, or null when empty or another thief won
+    Task* steal()
+    {
+        std::int64_t t = top_.load(std::memory_order_seq_cst);
+        const std::int64_t b = bottom_.load(std::memory_order_seq_cst);
+        if (t >= b)
+            return nullptr;
+        Task* task = slots_[t & MASK].load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return task;
+    }
+
+private:
+    static const std::int64_t MASK = static_cast<std::int64_t>(TASK_DEQUE_CAPACITY) - 1;
+
+    alignas(64) std::atomic<std::int64_t> top_{0};
+    alignas(64) std::atomic<std::int64_t> bottom_{0};
+    alignas(64) std::atomic<Task*> slots_[TASK_DEQUE_CAPACITY] = {};
+};
+
+class TaskPoolBase;
+
+struct TaskContext {
+    const TaskPoolBase* pool = nullptr;
+    unsigned worker = 0;
+};
+
+inline TaskContext& taskContext()
+{
+    thread_local TaskContext context;
+    return context;
+}
+
+// CPUs this process may run on, grouped by NUMA node in node order. One
+// group when the kernel exposes no nodes.
+inline std::vector<std::vector<int>> numaCpus()
+{
+    std::vector<std::vector<int>> nodes;
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof allowed, &allowed) != 0)
+        return nodes;
+    std::vector<int> ids;
+    if (DIR* dir = opendir("/sys/devices/system/node")) {
+        while (dirent* entry = readdir(dir)) {
+            int id;
+            char tail;
+            if (sscanf(entry->d_name, "node%d%c", &id, &tail) == 1)
+                ids.push_back(id);
+        }
+        closedir(dir);
+    }
+    std::sort(ids.begin(), ids.end());
+    for (int id : ids) {
+        char path[64];
+        snprintf(path, sizeof path, "/sys/devices/system/node/node%d/cpulist", id);
+        FILE* f = fopen(path, "r");
+        if (!f)
+            continue;
+        // "0-3,8-11"
+        std::vector<int> cpus;
+        int lo, hi, c;
+        while (fscanf(f, "%d", &lo) == 1) {
+            hi = lo;
+            if ((c = fgetc(f)) == '-') {
+                if (fscanf(f, "%d", &hi) != 1)
+                    break;
+                c = fgetc(f);
+            }
+            for (int cpu = lo; cpu <= hi; cpu++)
+                if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))
+                    cpus.push_back(cpu);
+            if (c != ',')
+                break;
+        }
+        fclose(f);
+        if (!cpus.empty())
+            nodes.push_back(cpus);
+    }
+    if (nodes.empty()) {
+        nodes.emplace_back();
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            if (CPU_ISSET(cpu, &allowed))
+                nodes.back().push_back(cpu);
+    }
+#endif
+    return nodes;
+}
+
+// The part of TaskPool that does not depend on the task types
+class TaskPoolBase {
+public:
+    TaskPoolBase(unsigned threads, Pinning pinning)
+        : size_(threads ? threads : hardwareThreads()), deques_(size_), victims_(size_)
+    {
+        // Pinned, worker w sits on CPU w of the node-by-node list; victims
+        // on its node come first
+        std::vector<int> cpuOf(size_, -1), nodeOf(size_, 0);
+        std::vector<std::vector<int>> nodes;
+        if (pinning == Pinning::Numa)
+            nodes = numaCpus();
+        std::vector<std::pair<int, int>> order; // (cpu, node)
+        for (std::size_t node = 0; node < nodes.size(); node++)
+            for (int cpu : nodes[node])
+                order.push_back({cpu, static_cast<int>(node)});
+        if (!order.empty()) {
+            for (unsigned w = 0; w < size_; w++) {
+                cpuOf[w] = order[w % order.size()].first;
+                nodeOf[w] = order[w % order.size()].second;
+            }
+        }
+        for (unsigned w = 0; w < size_; w++) {
+            for (int pass = 0; pass < 2; pass++)
+                for (unsigned v = 0; v < size_; v++)
+                    if (v != w && (nodeOf[v] == nodeOf[w]) == (pass == 0))
+                        victims_[w].push_back(v);
+        }
+        for (unsigned w = 1; w < size_; w++)
+            workers_.emplace_back([this, w, cpu = cpuOf[w]] { workerLoop(w, cpu); });
+    }
+
+    ~TaskPoolBase()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& t : workers_)
+            t.join();
+    }
+
+    TaskPoolBase(const TaskPoolBase&) = delete;
+    TaskPoolBase& operator=(const TaskPoolBase&) = delete;
+
+    unsigned size() const { return size_; }
+
+    // Worker of this pool running the calling task; 0 outside its tasks,
+    // including inside another pool's
+    unsigned currentWorker() const { return inside() ? taskContext().worker : 0; }
+
+protected:
+    bool inside() const { return taskContext().pool == this; }
+
+    // Run fn() as the root task with the caller as worker 0
+    template <class F>
+    void runRoot(F& fn)
+    {
+        std::lock_guard<std::mutex> driver(driving_);
+        const TaskContext saved = taskContext();
+        taskContext() = {this, 0};
+        if (size_ > 1) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                active_.store(true, std::memory_order_relaxed);
+                generation_++;
+            }
+            wake_.notify_all();
+        }
+        fn();
+        if (size_ > 1) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            active_.store(false, std::memory_order_relaxed);
+        }
+        taskContext() = saved;
+    }
+
+    // Run task on the calling worker's deque unless it is stolen; wait for
+    // it either way
+    void fork(Task& task, void (*first)(void*), void* firstArg)
+    {
+        const unsigned worker = taskContext().worker;
+        TaskDeque& deque = deques_[worker];
+        if (!deque.push(&task)) {
+            first(firstArg);
+            task.execute(&task);
+            return;
+        }
+        first(firstArg);
+        if (deque.pop() == &task) {
+            task.execute(&task);
+            return;
+        }
+        for (int spins = 0; !task.done.load(std::memory_order_acquire);) {
+            if (Task* other = stealFor(worker)) {
+                runStolen(other);
+                spins = 0;
+            } else if (++spins >= TASK_SPINS_BEFORE_YIELD) {
+                std::this_thread::yield();
+                spins = 0;
+            }
+        }
+    }
+
+private:
+    static void runStolen(Task* task)
+    {
+        task->execute(task);
+        task->done.store(true, std::memory_order_release);
+    }
+
+    // One pass over the victims, own node first, from a rotating start
+    Task* stealFor(unsigned worker)
+    {
+        const std::vector<unsigned>& victims = victims_[worker];
+        thread_local unsigned rotation = 0;
+        const std::size_t k = victims.size(), start = rotation++ % (k ? k : 1);
+        for (std::size_t i = 0; i < k; i++)
+            if (Task* task = deques_[victims[(start + i) % k]].steal())
+                return task;
+        return nullptr;
+    }
+
+    void workerLoop(unsigned worker, int cpu)
+    {
+#ifdef __linux__
+        if (cpu >= 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof set, &set);
+        }
+#else
+        (void)cpu;
+#endif
+        taskContext() = {this, worker};
+        unsigned long long seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_)
+                    return;
+                seen = generation_;
+            }
+            for (int spins = 0; active_.load(std::memory_order_relaxed);) {
+                if (Task* task = stealFor(worker)) {
+                    runStolen(task);
+                    spins = 0;
+                } else if (++spins >= TASK_SPINS_BEFORE_YIELD) {
+                    std::this_thread::yield();
+                    spins = 0;
+                }
+            }
+        }
+    }
+
+    unsigned size_;
+    std::vector<TaskDeque> deques_;
+    std::vector<std::vector<unsigned>> victims_;
+    std::vector<std::thread> workers_;
+    std::mutex driving_; // one root task at a time
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::atomic<bool> active_{false};
+    unsigned long long generation_ = 0;
+    bool stop_ = false;
+};
+
+} // namespace detail
+
+class TaskPool : public detail::TaskPoolBase {
+public:
+    // threads == 0 uses one worker per hardware thread
+    explicit TaskPool(unsigned threads = 0, Pinning pinning = Pinning::None) : TaskPoolBase(threads, pinning) {}
+
+    // Run fn() on the pool and return when it and everything it forked are
+    // done. Inside one of this pool's tasks it is a plain call.
+    template <class F>
+    void run(F&& fn)
+    {
+        if (inside())
+            fn();
+        else
+            runRoot(fn);
+    }
+
+    // a() and b(), possibly in parallel; returns when both are done
+    template <class A, class B>
+    void invoke(A&& a, B&& b)
+    {
+        if (!inside()) {
+            run([&] { invoke(a, b); });
+            return;
+        }
+        if (size() == 1) {
+            a();
+            b();
+            return;
+        }
+        detail::FunctionTask<typename std::remove_reference<B>::type> task(b);
+        using First = typename std::remove_reference<A>::type;
+        fork(task, [](void* f) { (*static_cast<First*>(f))(); }, const_cast<void*>(static_cast<const void*>(&a)));
+    }
+
+    // fn(worker, begin, end) over chunks of [0, n) of at most grain items,
+    // as ThreadPool::parallelFor(), by splitting the range in halves. It may
+    // be called from a task, and fn may fork in turn. grain == 0 picks about
+    // eight chunks per worker.
+    template <class F>
+    void parallelFor(std::size_t n, std::size_t grain, F&& fn)
+    {
+        if (n == 0)
+            return;
+        if (grain == 0)
+            grain = std::max<std::size_t>(1, n / (8 * static_cast<std::size_t>(size())));
+        if (size() == 1 || n <= grain) {
+            for (std::size_t b = 0; b < n; b += grain)
+                fn(currentWorker(), b, std::min(n, b + grain));
+            return;
+        }
+        run([&] { forRange(0, n, grain, fn); });
+    }
+
+private:
+    template <class F>
+    void forRange(std::size_t b, std::size_t e, std::size_t grain, F& fn)
+    {
+        if (e - b <= grain) {
+            fn(currentWorker(), b, e);
+            return;
+        }
+        const std::size_t mid = b + (e - b) / 2;
+        invoke([&] { forRange(b, mid, grain, fn); }, [&] { forRange(mid, e, grain, fn); });
+    }
+};
+
+// The process-wide pool, one worker per hardware thread, started on first use
+inline TaskPool& defaultTaskPool()
+{
+    static TaskPool pool;
+    return pool;
+}
+
+} // namespace algo
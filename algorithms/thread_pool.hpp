@@ -0,0 +1,129 @@
+// Fixed-size thread pool used by the parallel modes of the algorithms.
+// The calling thread takes part as worker 0, so a pool of size 1 runs
+// everything inline without ever waking another thread.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace algo {
+
+inline unsigned hardwareThreads()
+{
+    unsigned n = std::thread::hardware_concurrency();
+    return n ? n : 1;
+}
+
+class ThreadPool {
+public:
+    // threads == 0 uses one worker per hardware thread
+    explicit ThreadPool(unsigned threads = 0)
+        : size_(threads ? threads : hardwareThreads())
+    {
+        for (unsigned w = 1; w < size_; w++)
+            workers_.emplace_back([this, w] { workerLoop(w); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& t : workers_)
+            t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return size_; }
+
+    // Call fn(worker, begin, end) over chunks of [0, n) of at most grain
+    // items. Chunks are handed out dynamically; returns when all are done.
+    // grain == 0 picks about eight chunks per worker.
+    template <class F>
+    void parallelFor(std::size_t n, std::size_t grain, F&& fn)
+    {
+        if (n == 0)
+            return;
+        if (grain == 0)
+            grain = std::max<std::size_t>(1, n / (8 * static_cast<std::size_t>(size_)));
+        if (size_ == 1 || n <= grain) {
+            for (std::size_t b = 0; b < n; b += grain)
+                fn(0u, b, std::min(n, b + grain));
+            return;
+        }
+
+        std::atomic<std::size_t> next(0);
+        run([&](unsigned worker) {
+            for (;;) {
+                std::size_t b = next.fetch_add(grain, std::memory_order_relaxed);
+                if (b >= n)
+                    break;
+                fn(worker, b, std::min(n, b + grain));
+            }
+        });
+    }
+
+    // Call fn(worker) once on every worker and wait for all of them.
+    // Only one thread may drive the pool at a time, and fn must not call
+    // back into the same pool.
+    void run(const std::function<void(unsigned)>& fn)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = &fn;
+            pending_ = size_ - 1;
+            generation_++;
+        }
+        wake_.notify_all();
+        fn(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+        job_ = nullptr;
+    }
+
+private:
+    void workerLoop(unsigned worker)
+    {
+        unsigned long long seen = 0;
+        for (;;) {
+            const std::function<void(unsigned)>* job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_)
+                    return;
+                seen = generation_;
+                job = job_;
+            }
+            (*job)(worker);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--pending_ == 0)
+                    done_.notify_one();
+            }
+        }
+    }
+
+    unsigned size_;
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const std::function<void(unsigned)>* job_ = nullptr;
+    unsigned pending_ = 0;
+    unsigned long long generation_ = 0;
+    bool stop_ = false;
+};
+
+} // namespace algo
@@ -0,0 +1,881 @@
+// Benchmarks every algorithm in the repository, original and new, through
+// the shared harness and writes CSV (default) or JSON to stdout.
+//
+//   bench_all [--format csv|json] [--min N] [--max N] [--reps R] [--warmup W]
+//             [--filter NAME] [--dist random,sorted,reverse,duplicates]
+//             [--max-seconds S] [--seed S] [--threads T] [--counters]
+//
+// --counters adds the algorithm counters of a -DALGO_COUNTERS build and the
+// hardware counters perf_event_open() allows, per run, beside the times.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "algorithms/binary_file.hpp"
+#include "algorithms/convex_hull.hpp"
+#include "algorithms/counters.hpp"
+#include "algorithms/delta_stepping.hpp"
+#include "algorithms/dijkstra.hpp"
+#include "algorithms/fibonacci.hpp"
+#include "algorithms/fractional_knapsack.hpp"
+#include "algorithms/incremental_hull.hpp"
+#include "algorithms/insertion_sort.hpp"
+#include "algorithms/knapsack.hpp"
+#include "algorithms/kruskal.hpp"
+#include "algorithms/lcs.hpp"
+#include "algorithms/linear_search.hpp"
+#include "algorithms/merge_sort.hpp"
+#include "algorithms/miller_rabin.hpp"
+#include "algorithms/mst_parallel.hpp"
+#include "algorithms/nqueens.hpp"
+#include "algorithms/prime_sieve.hpp"
+#include "algorithms/quick_sort.hpp"
+#include "algorithms/radix_sort.hpp"
+#include "algorithms/reduce.hpp"
+#include "algorithms/search_batch.hpp"
+#include "algorithms/search_index.hpp"
+#include "algorithms/sequence_batch.hpp"
+#include "algorithms/sssp_batch.hpp"
+#include "algorithms/subset_sum.hpp"
+#include "algorithms/task_pool.hpp"
+#include "bench/harness.hpp"
+#include "bench/original.hpp"
+
+using bench::Distribution;
+using bench::Runner;
+
+namespace {
+
+const std::vector<Distribution> ALL_DISTRIBUTIONS = {Distribution::Random, Distribution::Sorted, Distribution::Reverse,
+                                                     Distribution::Duplicates};
+const std::vector<Distribution> RANDOM_ONLY = {Distribution::Random};
+
+// Lookups per run for the search cases
+const std::size_t SEARCH_QUERIES = 1 << 16;
+
+algo::ThreadPool* pool = nullptr;
+// Same thread count as pool, for the fork/join modes
+algo::TaskPool* tasks = nullptr;
+
+// n-element int array sorted in place by sort(data, n) on every run
+template <class Sort>
+bench::Case sortCase(const std::string& name, std::size_t maxSize, Sort sort)
+{
+    return {name, ALL_DISTRIBUTIONS, maxSize, [sort](std::size_t n, Distribution d, std::uint64_t seed) {
+                auto input = std::make_shared<std::vector<int>>(bench::generate<int>(n, d, seed));
+                auto work = std::make_shared<std::vector<int>>(n);
+                Runner r;
+                r.reset = [input, work] { std::copy(input->begin(), input->end(), work->begin()); };
+                r.run = [work, sort] { sort(work->data(), work->size()); };
+                return r;
+            }};
+}
+
+// Sorted table 0, 2, .., 2n-2 and SEARCH_QUERIES random keys, half of them misses
+template <class Search>
+bench::Case searchCase(const std::string& name, std::size_t maxSize, Search search)
+{
+    return {name, RANDOM_ONLY, maxSize, [search](std::size_t n, Distribution, std::uint64_t seed) {
+                auto table = std::make_shared<std::vector<int>>(n);
+                for (std::size_t i = 0; i < n; i++)
+                    (*table)[i] = static_cast<int>(2 * i);
+                auto keys = std::make_shared<std::vector<int>>(SEARCH_QUERIES);
+                std::mt19937_64 rng(seed);
+                for (int& k : *keys)
+                    k = static_cast<int>(rng() % (2 * n));
+                Runner r;
+                r.run = [table, keys, search] {
+                    long long sum = 0;
+                    for (int k : *keys)
+                        sum += search(table->data(), static_cast<int>(table->size()), k);
+                    bench::doNotOptimize(sum);
+                };
+                r.items = SEARCH_QUERIES;
+                return r;
+            }};
+}
+
+// searchCase() through an Index built from the table outside the timing
+template <class Index>
+bench::Case indexCase(const std::string& name, std::size_t maxSize)
+{
+    return {name, RANDOM_ONLY, maxSize, [](std::size_t n, Distribution, std::uint64_t seed) {
+                std::vector<int> table(n);
+                for (std::size_t i = 0; i < n; i++)
+                    table[i] = static_cast<int>(2 * i);
+                auto index = std::make_shared<Index>(table.data(), static_cast<int>(n));
+                auto keys = std::make_shared<std::vector<int>>(SEARCH_QUERIES);
+                std::mt19937_64 rng(seed);
+                for (int& k : *keys)
+                    k = static_cast<int>(rng() % (2 * n));
+                Runner r;
+                r.run = [index, keys] {
+                    long long sum = 0;
+                    for (int k : *keys)
+                        sum += index->find(k);
+                    bench::doNotOptimize(sum);
+                };
+                r.items = SEARCH_QUERIES;
+                return r;
+            }};
+}
+
+// searchCase() with all SEARCH_QUERIES keys in one call, ascending if sorted
+template <class Batch>
+bench::Case searchBatchCase(const std::string& name, std::size_t maxSize, bool sorted, Batch batch)
+{
+    return {name, RANDOM_ONLY, maxSize, [sorted, batch](std::size_t n, Distribution, std::uint64_t seed) {
+                auto table = std::make_shared<std::vector<int>>(n);
+                for (std::size_t i = 0; i < n; i++)
+                    (*table)[i] = static_cast<int>(2 * i);
+                auto keys = std::make_shared<std::vector<int>>(SEARCH_QUERIES);
+                std::mt19937_64 rng(seed);
+                for (int& k : *keys)
+                    k = static_cast<int>(rng() % (2 * n));
+                if (sorted)
+                    std::sort(keys->begin(), keys->end());
+                auto results = std::make_shared<std::vector<int>>(SEARCH_QUERIES);
+                Runner r;
+                r.run = [table, keys, results, batch] {
+                    batch(table->data(), static_cast<int>(table->size()), keys->data(), keys->size(), results->data());
+                    bench::doNotOptimize(results->data());
+                };
+                r.items = SEARCH_QUERIES;
+                return r;
+            }};
+}
+
+// One pass over an unsorted column of n random non-negative ints
+template <class Scan>
+bench::Case scanCase(const std::string& name, std::size_t maxSize, Scan scan)
+{
+    return {name, RANDOM_ONLY, maxSize, [scan](std::size_t n, Distribution, std::uint64_t seed) {
+                auto column = std::make_shared<std::vector<int>>(n);
+                std::mt19937_64 rng(seed);
+                for (int& x : *column)
+                    x = static_cast<int>(rng() >> 33);
+                Runner r;
+                r.run = [column, scan] { bench::doNotOptimize(scan(column->data(), column->size())); };
+                r.items = n;
+                return r;
+            }};
+}
+
+std::vector<algo::Edge> randomEdges(std::size_t n, std::size_t m, std::uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::vector<algo::Edge> edges(m);
+    for (algo::Edge& e : edges)
+        e = {static_cast<int>(rng() % n), static_cast<int>(rng() % n), static_cast<int>(1 + rng() % 100)};
+    return edges;
+}
+
+// Random graph with n vertices and 4n edges; items are edges
+template <class Run>
+bench::Case graphCase(const std::string& name, std::size_t maxSize, bool undirected, Run run)
+{
+    return {name, RANDOM_ONLY, maxSize, [run, undirected](std::size_t n, Distribution, std::uint64_t seed) {
+                auto edges = std::make_shared<std::vector<algo::Edge>>(randomEdges(n, 4 * n, seed));
+                auto g = std::make_shared<algo::CsrGraph>(algo::buildCsr(static_cast<int>(n), *edges, undirected));
+                Runner r;
+                r.run = [edges, g, run] { run(*g, *edges); };
+                r.items = static_cast<double>(edges->size());
+                return r;
+            }};
+}
+
+void addSorts(bench::Harness& h)
+{
+    h.add(sortCase("original/insertionSort", 100000, [](int* a, std::size_t n) {
+        original::insertionSort(a, static_cast<int>(n));
+    }));
+    h.add(sortCase("original/mergeSort", 100000000, [](int* a, std::size_t n) {
+        original::mergeSort(a, 0, static_cast<int>(n) - 1);
+    }));
+    // Lomuto on sorted input recurses n deep; keep it below stack limits
+    h.add(sortCase("original/quickSort", 10000, [](int* a, std::size_t n) {
+        original::quickSort(a, 0, static_cast<int>(n) - 1);
+    }));
+    h.add(sortCase("insertionSort", 100000, [](int* a, std::size_t n) { algo::insertionSort(a, n); }));
+    h.add(sortCase("insertionSort/binary", 100000, [](int* a, std::size_t n) { algo::binaryInsertionSort(a, n); }));
+    // Leaf-sized runs, the way the quick sort leaves see them
+    h.add(sortCase("insertionSort/runs16", 10000000, [](int* a, std::size_t n) {
+        for (std::size_t i = 0; i < n; i += algo::SORT_NETWORK_MAX)
+            algo::insertionSort(a + i, std::min(algo::SORT_NETWORK_MAX, n - i));
+    }));
+    h.add(sortCase("networkSort/runs16", 10000000, [](int* a, std::size_t n) {
+        for (std::size_t i = 0; i < n; i += algo::SORT_NETWORK_MAX)
+            algo::networkSort(a + i, std::min(algo::SORT_NETWORK_MAX, n - i));
+    }));
+    h.add(sortCase("mergeSort", 100000000, [](int* a, std::size_t n) { algo::mergeSort(a, n); }));
+    h.add(sortCase("parallelMergeSort", 100000000, [](int* a, std::size_t n) {
+        algo::parallelMergeSort(a, n, *tasks);
+    }));
+    h.add(sortCase("quickSort", 100000000, [](int* a, std::size_t n) { algo::quickSort(a, n); }));
+    h.add(sortCase("parallelQuickSort", 100000000, [](int* a, std::size_t n) {
+        algo::parallelQuickSort(a, n, *tasks);
+    }));
+    h.add(sortCase("quickSortInt/block", 100000000, [](int* a, std::size_t n) {
+        algo::quickSortInt(a, n, algo::PartitionKernel::Block);
+    }));
+    h.add(sortCase("quickSortInt/auto", 100000000, [](int* a, std::size_t n) { algo::quickSortInt(a, n); }));
+    h.add(sortCase("heapSort", 100000000, [](int* a, std::size_t n) { algo::heapSort(a, n); }));
+    h.add(sortCase("radixSort", 100000000, [](int* a, std::size_t n) { algo::radixSort(a, n); }));
+    h.add(sortCase("parallelRadixSort", 100000000, [](int* a, std::size_t n) {
+        algo::parallelRadixSort(a, n, *pool);
+    }));
+    h.add(sortCase("std::sort", 100000000, [](int* a, std::size_t n) { std::sort(a, a + n); }));
+}
+
+void addSearches(bench::Harness& h)
+{
+    h.add(searchCase("original/binarySearch", 100000000, [](const int* a, int n, int k) {
+        return original::binarySearch(a, n, k);
+    }));
+    h.add(searchCase("original/recursiveBinarySearch", 100000000, [](const int* a, int n, int k) {
+        return original::recursiveBinarySearch(a, 0, n - 1, k);
+    }));
+    h.add(searchCase("original/linearSearch", 100000, [](const int* a, int n, int k) {
+        return original::linearSearch(a, n, k);
+    }));
+    h.add(searchCase("linearSearch", 100000, [](const int* a, int n, int k) {
+        return algo::linearSearch(a, static_cast<std::size_t>(n), k);
+    }));
+    // -1 never occurs, so findFirst() reads the whole column
+    h.add(scanCase("findFirst", 100000000, [](const int* a, std::size_t n) { return algo::findFirst(a, n, -1); }));
+    h.add(scanCase("findFirst/parallel", 100000000,
+                   [](const int* a, std::size_t n) { return algo::findFirst(a, n, -1, *pool); }));
+    h.add(scanCase("countEqual", 100000000, [](const int* a, std::size_t n) { return algo::countEqual(a, n, 12345); }));
+    h.add(scanCase("countEqual/parallel", 100000000,
+                   [](const int* a, std::size_t n) { return algo::countEqual(a, n, 12345, *pool); }));
+    h.add(searchCase("binarySearch", 100000000, [](const int* a, int n, int k) { return algo::binarySearch(a, n, k); }));
+    h.add(indexCase<algo::EytzingerIndex>("EytzingerIndex", 100000000));
+    h.add(indexCase<algo::STreeIndex>("STreeIndex", 100000000));
+    h.add(searchBatchCase("binarySearchBatch", 100000000, false,
+                          [](const int* a, int n, const int* k, std::size_t m, int* out) {
+                              algo::binarySearchBatch(a, n, k, m, out);
+                          }));
+    h.add(searchBatchCase("binarySearchBatch/parallel", 100000000, false,
+                          [](const int* a, int n, const int* k, std::size_t m, int* out) {
+                              algo::binarySearchBatch(a, n, k, m, out, pool);
+                          }));
+    h.add(searchBatchCase("binarySearchSortedBatch", 100000000, true,
+                          [](const int* a, int n, const int* k, std::size_t m, int* out) {
+                              algo::binarySearchSortedBatch(a, n, k, m, out);
+                          }));
+}
+
+void addGraphs(bench::Harness& h)
+{
+    // The matrix version needs n^2 ints
+    h.add({"original/dijkstra", RANDOM_ONLY, 1000, [](std::size_t n, Distribution, std::uint64_t seed) {
+               auto edges = randomEdges(n, 4 * n, seed);
+               auto G = std::make_shared<std::vector<int>>(n * n, 0);
+               for (const algo::Edge& e : edges)
+                   if (e.u != e.v)
+                       (*G)[e.u * n + e.v] = e.w;
+               auto out = std::make_shared<std::vector<int>>(2 * n);
+               Runner r;
+               r.run = [G, out, n] {
+                   original::dijkstra(G->data(), static_cast<int>(n), 0, out->data(), out->data() + n);
+               };
+               r.items = static_cast<double>(edges.size());
+               return r;
+           }});
+    h.add(graphCase("dijkstra", 10000000, false, [](const algo::CsrGraph& g, const std::vector<algo::Edge>&) {
+        std::vector<long long> distance;
+        std::vector<int> pred;
+        algo::dijkstra(g, 0, distance, pred);
+        bench::doNotOptimize(distance.data());
+    }));
+    h.add(graphCase("deltaStepping", 10000000, false, [](const algo::CsrGraph& g, const std::vector<algo::Edge>&) {
+        std::vector<long long> distance;
+        std::vector<int> pred;
+        algo::deltaStepping(g, 0, 0, *pool, distance, pred);
+        bench::doNotOptimize(distance.data());
+    }));
+    h.add(graphCase("dijkstraBatch/16", 100000, false, [](const algo::CsrGraph& g, const std::vector<algo::Edge>&) {
+        std::vector<int> sources(16);
+        for (int i = 0; i < 16; i++)
+            sources[i] = static_cast<int>(static_cast<long long>(i) * g.n / 16);
+        bench::doNotOptimize(algo::dijkstraBatch(g, sources, false, pool).distance.data());
+    }));
+
+    h.add({"original/kruskal", RANDOM_ONLY, 100, [](std::size_t n, Distribution, std::uint64_t seed) {
+               auto edges = randomEdges(n, 4 * n, seed);
+               auto cost = std::make_shared<std::vector<int>>((n + 1) * (n + 1), 0);
+               for (const algo::Edge& e : edges)
+                   if (e.u != e.v)
+                       (*cost)[(e.u + 1) * (n + 1) + e.v + 1] = (*cost)[(e.v + 1) * (n + 1) + e.u + 1] = e.w;
+               Runner r;
+               r.run = [cost, n] { bench::doNotOptimize(original::kruskal(*cost, static_cast<int>(n))); };
+               r.items = static_cast<double>(edges.size());
+               return r;
+           }});
+    h.add(graphCase("kruskal", 1000000, true, [](const algo::CsrGraph& g, const std::vector<algo::Edge>& e) {
+        bench::doNotOptimize(algo::kruskal(g.n, e).mincost);
+    }));
+    h.add(graphCase("boruvka", 1000000, true, [](const algo::CsrGraph& g, const std::vector<algo::Edge>& e) {
+        bench::doNotOptimize(algo::boruvka(g.n, e, *pool).mincost);
+    }));
+}
+
+// n random items (weight 1..100, value 1..1000), capacity 1000; items are
+// DP cells. solve(W, wt, val, n) is the timed call.
+template <class Solve>
+bench::Case knapsackCase(const std::string& name, std::size_t maxSize, Solve solve)
+{
+    return {name, RANDOM_ONLY, maxSize, [solve](std::size_t n, Distribution, std::uint64_t seed) {
+                const int W = 1000;
+                std::mt19937_64 rng(seed);
+                auto wt = std::make_shared<std::vector<int>>(n), val = std::make_shared<std::vector<int>>(n);
+                for (std::size_t i = 0; i < n; i++) {
+                    (*wt)[i] = static_cast<int>(1 + rng() % 100);
+                    (*val)[i] = static_cast<int>(1 + rng() % 1000);
+                }
+                Runner r;
+                r.run = [wt, val, W, solve] { solve(W, wt->data(), val->data(), static_cast<int>(wt->size())); };
+                r.items = static_cast<double>(n) * (W + 1);
+                return r;
+            }};
+}
+
+// Two random DNA strings of length n; items are DP cells. solve(x, y, n)
+// is the timed call.
+template <class Solve>
+bench::Case lcsCase(const std::string& name, std::size_t maxSize, Solve solve)
+{
+    return {name, RANDOM_ONLY, maxSize, [solve](std::size_t n, Distribution, std::uint64_t seed) {
+                std::mt19937_64 rng(seed);
+                auto x = std::make_shared<std::string>(n, 'A'), y = std::make_shared<std::string>(n, 'A');
+                for (std::size_t i = 0; i < n; i++) {
+                    (*x)[i] = "ACGT"[rng() % 4];
+                    (*y)[i] = "ACGT"[rng() % 4];
+                }
+                Runner r;
+                r.run = [x, y, solve] { solve(x->data(), y->data(), static_cast<int>(x->size())); };
+                r.items = static_cast<double>(n) * n;
+                return r;
+            }};
+}
+
+// n random points in the disk of radius 2^30 around the origin
+std::vector<algo::Point> randomDiskPoints(std::size_t n, std::uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    std::vector<algo::Point> points;
+    points.reserve(n);
+    while (points.size() < n) {
+        double x = unit(rng), y = unit(rng);
+        if (x * x + y * y <= 1.0)
+            points.push_back({static_cast<int>(x * (1 << 30)), static_cast<int>(y * (1 << 30))});
+    }
+    return points;
+}
+
+void addOthers(bench::Harness& h)
+{
+    h.add({"original/maxMinDivideConquer", RANDOM_ONLY, 100000000, [](std::size_t n, Distribution d, std::uint64_t seed) {
+               auto data = std::make_shared<std::vector<int>>(bench::generate<int>(n, d, seed));
+               Runner r;
+               r.run = [data] {
+                   bench::doNotOptimize(original::maxMinDivideConquer(data->data(), 0, static_cast<int>(data->size()) - 1));
+               };
+               return r;
+           }});
+    h.add(scanCase("minMax", 100000000, [](const int* a, std::size_t n) { return algo::minMax(a, n); }));
+    h.add(scanCase("minMax/pairwise", 100000000,
+                   [](const int* a, std::size_t n) { return algo::minMaxPairwise(a, n); }));
+    h.add(scanCase("minMax/parallel", 100000000, [](const int* a, std::size_t n) { return algo::minMax(a, n, tasks); }));
+    h.add(scanCase("reduce/argMin", 100000000, [](const int* a, std::size_t n) {
+        return algo::reduce(a, n, algo::ArgMinReducer<int>()).index;
+    }));
+    h.add(scanCase("reduce/argMin/parallel", 100000000, [](const int* a, std::size_t n) {
+        return algo::reduce(a, n, algo::ArgMinReducer<int>(), tasks).index;
+    }));
+    h.add(scanCase("reduce/sum", 100000000,
+                   [](const int* a, std::size_t n) { return algo::reduce(a, n, algo::SumReducer<int>()); }));
+
+    // n items, capacity 1000; items are DP cells
+    h.add(knapsackCase("original/knapsack", 10000, [](int W, const int* wt, const int* val, int n) {
+        bench::doNotOptimize(original::knapsack(W, wt, val, n));
+    }));
+    h.add(knapsackCase("knapsack", 1000000, [](int W, const int* wt, const int* val, int n) {
+        bench::doNotOptimize(algo::knapsack(W, wt, val, n));
+    }));
+    h.add(knapsackCase("knapsackWithItems/bitmap", 1000000, [](int W, const int* wt, const int* val, int n) {
+        bench::doNotOptimize(algo::knapsackWithItems(W, wt, val, n, algo::KnapsackReconstruction::Bitmap).value);
+    }));
+    h.add(knapsackCase("knapsackWithItems/divide", 1000000, [](int W, const int* wt, const int* val, int n) {
+        bench::doNotOptimize(
+            algo::knapsackWithItems(W, wt, val, n, algo::KnapsackReconstruction::DivideAndConquer).value);
+    }));
+    h.add(knapsackCase("knapsackMaxFill", 1000000, [](int W, const int* wt, const int*, int n) {
+        bench::doNotOptimize(algo::knapsackMaxFill(W, wt, n));
+    }));
+
+    // Two random DNA strings of length n; items are DP cells
+    h.add(lcsCase("original/lcs", 10000, [](const char* x, const char* y, int n) {
+        bench::doNotOptimize(original::lcs(x, y, n, n));
+    }));
+    h.add(lcsCase("lcs", 10000, [](const char* x, const char* y, int n) { bench::doNotOptimize(algo::lcs(x, y, n, n)); }));
+    h.add(lcsCase("parallelLcs", 10000, [](const char* x, const char* y, int n) {
+        bench::doNotOptimize(algo::parallelLcs(x, y, n, n, *pool));
+    }));
+    h.add(lcsCase("lcsLength", 100000, [](const char* x, const char* y, int n) {
+        bench::doNotOptimize(algo::lcsLength(x, y, n, n));
+    }));
+    // The rolling-row DP the Span front-end runs for element types other than char
+    h.add(lcsCase("lcsLength/generic", 10000, [](const char* x, const char* y, int n) {
+        bench::doNotOptimize(algo::lcsLength(algo::span(x, n), algo::span(y, n), std::equal_to<char>()));
+    }));
+    h.add(lcsCase("lcsHirschberg", 100000, [](const char* x, const char* y, int n) {
+        bench::doNotOptimize(algo::lcsHirschberg(x, y, n, n).size());
+    }));
+
+    // n random record pairs of 8 .. 64 letters, b a mutated copy of a
+    for (bool edit : {false, true}) {
+        h.add({edit ? "editDistanceBatch" : "lcsBatch", RANDOM_ONLY, 10000000,
+               [edit](std::size_t n, Distribution, std::uint64_t seed) {
+                   std::mt19937_64 rng(seed);
+                   auto text = std::make_shared<std::vector<std::string>>(2 * n);
+                   auto pairs = std::make_shared<std::vector<algo::SequencePair>>(n);
+                   auto scores = std::make_shared<std::vector<int>>(n);
+                   for (std::size_t p = 0; p < n; p++) {
+                       std::string& a = (*text)[2 * p];
+                       std::string& b = (*text)[2 * p + 1];
+                       a.resize(8 + rng() % 57);
+                       for (char& c : a)
+                           c = static_cast<char>('a' + rng() % 26);
+                       b = a;
+                       for (int k = 0; k < 4; k++)
+                           b[rng() % b.size()] = static_cast<char>('a' + rng() % 26);
+                       (*pairs)[p] = {a.data(), static_cast<int>(a.size()), b.data(), static_cast<int>(b.size())};
+                   }
+                   Runner r;
+                   r.run = [text, pairs, scores, edit] {
+                       if (edit)
+                           algo::editDistanceBatch(pairs->data(), pairs->size(), scores->data(), pool);
+                       else
+                           algo::lcsBatch(pairs->data(), pairs->size(), scores->data(), pool);
+                       bench::doNotOptimize(scores->data());
+                   };
+                   return r;
+               }});
+    }
+
+    // n elements of 1 .. 1000, target half their total; items are DP cells
+    h.add({"subsetSumReachable", RANDOM_ONLY, 10000, [](std::size_t n, Distribution, std::uint64_t seed) {
+               std::mt19937_64 rng(seed);
+               auto set = std::make_shared<std::vector<int>>(n);
+               long long total = 0;
+               for (int& x : *set) {
+                   x = static_cast<int>(1 + rng() % 1000);
+                   total += x;
+               }
+               int target = static_cast<int>(total / 2);
+               Runner r;
+               r.run = [set, target] {
+                   bench::doNotOptimize(algo::subsetSumReachable(set->data(), static_cast<int>(set->size()), target));
+               };
+               r.items = static_cast<double>(n) * target;
+               return r;
+           }});
+
+    // Solutions of the 8 + log10(n) queens board, 10 at n = 100 up to 14;
+    // items are solutions
+    for (bool parallel : {false, true}) {
+        h.add({parallel ? "nQueensCount/tasks" : "nQueensCount", RANDOM_ONLY, 1000000,
+               [parallel](std::size_t n, Distribution, std::uint64_t) {
+                   int queens = 8;
+                   for (std::size_t m = n; m >= 10; m /= 10)
+                       queens++;
+                   Runner r;
+                   r.run = [queens, parallel] {
+                       bench::doNotOptimize(parallel ? algo::nQueensCount(queens, *tasks) : algo::nQueensCount(queens));
+                   };
+                   r.items = static_cast<double>(algo::nQueensCount(queens));
+                   return r;
+               }});
+    }
+
+    // n odd numbers below 2^31 (the original overflows above that)
+    h.add({"original/is_prime", RANDOM_ONLY, 1000000, [](std::size_t n, Distribution, std::uint64_t seed) {
+               std::mt19937_64 rng(seed);
+               auto numbers = std::make_shared<std::vector<long long>>(n);
+               for (long long& x : *numbers)
+                   x = static_cast<long long>(rng() % (1ull << 31)) | 1;
+               Runner r;
+               r.run = [numbers] {
+                   int primes = 0;
+                   for (long long x : *numbers)
+                       primes += original::is_prime(x, 5);
+                   bench::doNotOptimize(primes);
+               };
+               return r;
+           }});
+
+    // The same inputs for the deterministic test, then full 64-bit ones
+    for (int bits : {31, 64}) {
+        for (bool parallel : {false, true}) {
+            std::string name = std::string(parallel ? "isPrimeBatch/parallel/" : "isPrimeBatch/") + std::to_string(bits);
+            h.add({name, RANDOM_ONLY, 10000000, [bits, parallel](std::size_t n, Distribution, std::uint64_t seed) {
+                       std::mt19937_64 rng(seed);
+                       auto numbers = std::make_shared<std::vector<std::uint64_t>>(n);
+                       for (std::uint64_t& x : *numbers)
+                           x = (bits == 64 ? rng() : rng() % (1ull << 31)) | 1;
+                       auto out = std::make_shared<std::vector<std::uint8_t>>(n);
+                       Runner r;
+                       r.run = [numbers, out, parallel] {
+                           algo::isPrimeBatch(numbers->data(), numbers->size(), out->data(), parallel ? pool : nullptr);
+                           bench::doNotOptimize(out->data());
+                       };
+                       return r;
+                   }});
+        }
+    }
+
+    // The primes of [10^12, 10^12 + n], then of [10^18, 10^18 + n]
+    for (bool high : {false, true}) {
+        for (bool parallel : {false, true}) {
+            std::string name = std::string(parallel ? "sieveRange/parallel" : "sieveRange") + (high ? "/1e18" : "");
+            h.add({name, RANDOM_ONLY, high ? std::size_t(100000000) : std::size_t(1000000000),
+                   [high, parallel](std::size_t n, Distribution, std::uint64_t) {
+                       Runner r;
+                       r.run = [n, high, parallel] {
+                           const std::uint64_t lo = high ? 1000000000000000000ull : 1000000000000ull;
+                           algo::SievedRange range(lo, lo + n, parallel ? pool : nullptr);
+                           bench::doNotOptimize(range.isPrime(lo + 39));
+                       };
+                       return r;
+                   }});
+        }
+    }
+
+    // n random points in a disk of radius 2^30, about 3 n^(1/3) on the hull
+    // mode 0 sequential, 1 on the TaskPool
+    const char* const hullNames[] = {"convexHull", "convexHull/parallel"};
+    for (int mode = 0; mode < 2; mode++) {
+        h.add({hullNames[mode], RANDOM_ONLY, 100000000, [mode](std::size_t n, Distribution, std::uint64_t seed) {
+                   auto input = std::make_shared<std::vector<algo::Point>>(randomDiskPoints(n, seed));
+                   auto work = std::make_shared<std::vector<algo::Point>>(n);
+                   auto hull = std::make_shared<std::vector<algo::Point>>(n + 1);
+                   Runner r;
+                   r.reset = [input, work] { *work = *input; };
+                   r.run = [work, hull, mode] {
+                       bench::doNotOptimize(mode == 1 ? algo::convexHull(work->data(), work->size(), hull->data(), *tasks)
+                                                      : algo::convexHull(work->data(), work->size(), hull->data()));
+                   };
+                   return r;
+               }});
+    }
+
+    // The same points streamed into an IncrementalHull one by one, then
+    // SEARCH_QUERIES random contains() queries against the result
+    h.add({"incrementalHull/insert", RANDOM_ONLY, 100000000, [](std::size_t n, Distribution, std::uint64_t seed) {
+               auto input = std::make_shared<std::vector<algo::Point>>(randomDiskPoints(n, seed));
+               Runner r;
+               r.run = [input] {
+                   algo::IncrementalHull hull;
+                   for (const algo::Point& p : *input)
+                       hull.insert(p);
+                   bench::doNotOptimize(hull.hull().size());
+               };
+               return r;
+           }});
+    h.add({"incrementalHull/contains", RANDOM_ONLY, 100000000, [](std::size_t n, Distribution, std::uint64_t seed) {
+               auto hull = std::make_shared<algo::IncrementalHull>(randomDiskPoints(n, seed));
+               auto queries = std::make_shared<std::vector<algo::Point>>(randomDiskPoints(SEARCH_QUERIES, seed + 1));
+               Runner r;
+               r.run = [hull, queries] {
+                   std::size_t inside = 0;
+                   for (const algo::Point& q : *queries)
+                       inside += hull->contains(q);
+                   bench::doNotOptimize(inside);
+               };
+               r.items = SEARCH_QUERIES;
+               return r;
+           }});
+
+    h.add({"original/fractionalKnapsack", RANDOM_ONLY, 10000000, [](std::size_t n, Distribution, std::uint64_t seed) {
+               std::mt19937_64 rng(seed);
+               auto input = std::make_shared<std::vector<original::Item>>(n);
+               long long total = 0;
+               for (std::size_t i = 0; i < n; i++) {
+                   original::Item& it = (*input)[i];
+                   it.itemId = static_cast<int>(i + 1);
+                   it.weight = static_cast<int>(1 + rng() % 100);
+                   it.profit = static_cast<int>(1 + rng() % 1000);
+                   it.pByw = (float)it.profit / it.weight;
+                   total += it.weight;
+               }
+               auto work = std::make_shared<std::vector<original::Item>>(n);
+               int capacity = static_cast<int>(std::min<long long>(total / 10, 1 << 30));
+               Runner r;
+               r.reset = [input, work] { *work = *input; };
+               r.run = [work, capacity] {
+                   bench::doNotOptimize(original::fractionalKnapsack(work->data(), static_cast<int>(work->size()), capacity));
+               };
+               return r;
+           }});
+    // The same items and capacity as separate weight and profit columns
+    for (bool sorted : {false, true}) {
+        h.add({sorted ? "fractionalKnapsack/partialSort" : "fractionalKnapsack", RANDOM_ONLY, 10000000,
+               [sorted](std::size_t n, Distribution, std::uint64_t seed) {
+                   std::mt19937_64 rng(seed);
+                   auto weight = std::make_shared<std::vector<int>>(n), profit = std::make_shared<std::vector<int>>(n);
+                   long long total = 0;
+                   for (std::size_t i = 0; i < n; i++) {
+                       (*weight)[i] = static_cast<int>(1 + rng() % 100);
+                       (*profit)[i] = static_cast<int>(1 + rng() % 1000);
+                       total += (*weight)[i];
+                   }
+                   long long capacity = std::min<long long>(total / 10, 1 << 30);
+                   auto solver = std::make_shared<algo::FractionalKnapsack>();
+                   Runner r;
+                   r.run = [weight, profit, capacity, solver, sorted] {
+                       algo::FractionalMode mode = sorted ? algo::FractionalMode::PartialSort : algo::FractionalMode::Select;
+                       bench::doNotOptimize(solver->solve({weight->data(), profit->data(), weight->size()}, capacity, mode).profit);
+                   };
+                   return r;
+               }});
+    }
+
+    // n problems of 16 .. 1024 items each, capacity a tenth of their weight
+    for (bool parallel : {false, true}) {
+        h.add({parallel ? "fractionalKnapsackBatch/parallel" : "fractionalKnapsackBatch", RANDOM_ONLY, 100000,
+               [parallel](std::size_t n, Distribution, std::uint64_t seed) {
+                   std::mt19937_64 rng(seed);
+                   auto problems = std::make_shared<std::vector<algo::FractionalProblem>>(n);
+                   auto offsets = std::vector<std::size_t>(n + 1, 0);
+                   for (std::size_t p = 0; p < n; p++)
+                       offsets[p + 1] = offsets[p] + 16 + rng() % 1009;
+                   auto weight = std::make_shared<std::vector<int>>(offsets[n]), profit = std::make_shared<std::vector<int>>(offsets[n]);
+                   for (std::size_t p = 0; p < n; p++) {
+                       long long total = 0;
+                       for (std::size_t i = offsets[p]; i < offsets[p + 1]; i++) {
+                           (*weight)[i] = static_cast<int>(1 + rng() % 100);
+                           (*profit)[i] = static_cast<int>(1 + rng() % 1000);
+                           total += (*weight)[i];
+                       }
+                       (*problems)[p] = {{weight->data() + offsets[p], profit->data() + offsets[p], offsets[p + 1] - offsets[p]},
+                                         total / 10};
+                   }
+                   auto solutions = std::make_shared<std::vector<algo::FractionalSolution>>(n);
+                   Runner r;
+                   r.run = [weight, profit, problems, solutions, parallel] {
+                       algo::fractionalKnapsackBatch(problems->data(), problems->size(), solutions->data(),
+                                                     parallel ? pool : nullptr);
+                       bench::doNotOptimize(solutions->data());
+                   };
+                   return r;
+               }});
+    }
+
+    // n terms; the original's wrap after the 46th, the new ones are exact
+    h.add({"original/fibonacciSeries", RANDOM_ONLY, 100000000, [](std::size_t n, Distribution, std::uint64_t) {
+               Runner r;
+               r.run = [n] { bench::doNotOptimize(original::fibonacciSeries(static_cast<int>(n))); };
+               return r;
+           }});
+    // The text grows with n^2; items are terms
+    h.add({"fibonacciSeries/text", RANDOM_ONLY, 10000, [](std::size_t n, Distribution, std::uint64_t) {
+               auto text = std::make_shared<std::string>();
+               Runner r;
+               r.run = [n, text] {
+                   text->clear();
+                   algo::appendFibonacciSeries(n, *text);
+                   bench::doNotOptimize(text->data());
+               };
+               return r;
+           }});
+    // n queries at random 64-bit indices
+    h.add({"fibonacciMod", RANDOM_ONLY, 1000000, [](std::size_t n, Distribution, std::uint64_t seed) {
+               std::mt19937_64 rng(seed);
+               auto indices = std::make_shared<std::vector<std::uint64_t>>(n);
+               for (std::uint64_t& x : *indices)
+                   x = rng();
+               Runner r;
+               r.run = [indices] {
+                   std::uint64_t sum = 0;
+                   for (std::uint64_t x : *indices)
+                       sum += algo::fibonacciMod(x, 1000000007);
+                   bench::doNotOptimize(sum);
+               };
+               return r;
+           }});
+    // F(n) exactly; items are n
+    for (bool parallel : {false, true}) {
+        h.add({parallel ? "fibonacciBig/parallel" : "fibonacciBig", RANDOM_ONLY, 1000000,
+               [parallel](std::size_t n, Distribution, std::uint64_t) {
+                   Runner r;
+                   r.run = [n, parallel] { bench::doNotOptimize(algo::fibonacciBig(n, parallel ? pool : nullptr).digits()); };
+                   return r;
+               }});
+    }
+
+    // n numbers as edge-list text; the original programs read them with scanf
+    auto numberText = [](std::size_t n, std::uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        auto text = std::make_shared<std::string>();
+        for (std::size_t i = 0; i < n; i++)
+            *text += std::to_string(rng() % 1000000) + (i % 3 == 2 ? '\n' : ' ');
+        return text;
+    };
+    h.add({"original/fscanf", RANDOM_ONLY, 10000000, [numberText](std::size_t n, Distribution, std::uint64_t seed) {
+               auto text = numberText(n, seed);
+               auto out = std::make_shared<std::vector<int>>();
+               Runner r;
+               r.run = [text, out] {
+                   out->clear();
+                   FILE* f = fmemopen(&(*text)[0], text->size(), "r");
+                   for (int x; f && fscanf(f, "%d", &x) == 1;)
+                       out->push_back(x);
+                   if (f)
+                       fclose(f);
+                   bench::doNotOptimize(out->data());
+               };
+               return r;
+           }});
+    for (bool parallel : {false, true}) {
+        h.add({parallel ? "parseInts/parallel" : "parseInts", RANDOM_ONLY, 10000000,
+               [numberText, parallel](std::size_t n, Distribution, std::uint64_t seed) {
+                   auto text = numberText(n, seed);
+                   auto out = std::make_shared<std::vector<int>>();
+                   Runner r;
+                   r.run = [text, out, parallel] {
+                       out->clear();
+                       algo::parseInts(text->data(), text->size(), *out, parallel ? pool : nullptr);
+                       bench::doNotOptimize(out->data());
+                   };
+                   return r;
+               }});
+    }
+}
+
+bool parseSize(const char* s, std::size_t& out)
+{
+    char* end;
+    double v = strtod(s, &end); // accepts 1e6 as well as 1000000
+    if (*end || v < 1)
+        return false;
+    out = static_cast<std::size_t>(v);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bench::Config config;
+    bool json = false;
+    unsigned threads = 0;
+    bool counters = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (!strcmp(arg, "--counters")) {
+            counters = true;
+            continue;
+        }
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        bool ok = value != nullptr;
+        if (!strcmp(arg, "--format") && value)
+            json = !strcmp(value, "json");
+        else if (!strcmp(arg, "--min") && value)
+            ok = parseSize(value, config.minSize);
+        else if (!strcmp(arg, "--max") && value)
+            ok = parseSize(value, config.maxSize);
+        else if (!strcmp(arg, "--reps") && value)
+            config.repetitions = std::max(1, atoi(value));
+        else if (!strcmp(arg, "--warmup") && value)
+            config.warmup = std::max(0, atoi(value));
+        else if (!strcmp(arg, "--filter") && value)
+            config.filter = value;
+        else if (!strcmp(arg, "--max-seconds") && value)
+            config.maxRunSeconds = atof(value);
+        else if (!strcmp(arg, "--seed") && value)
+            config.seed = strtoull(value, nullptr, 10);
+        else if (!strcmp(arg, "--threads") && value)
+            threads = static_cast<unsigned>(atoi(value));
+        else if (!strcmp(arg, "--dist") && value) {
+            std::string list = value;
+            for (std::size_t start = 0; start <= list.size();) {
+                std::size_t comma = std::min(list.find(',', start), list.size());
+                Distribution d;
+                if (!bench::parseDistribution(list.substr(start, comma - start), d))
+                    ok = false;
+                else
+                    config.distributions.push_back(d);
+                start = comma + 1;
+            }
+        } else
+            ok = false;
+        if (!ok) {
+            fprintf(stderr, "usage: %s [--format csv|json] [--min N] [--max N] [--reps R] [--warmup W] "
+                            "[--filter NAME] [--dist LIST] [--max-seconds S] [--seed S] [--threads T] [--counters]\n",
+                    argv[0]);
+            return 1;
+        }
+        i++;
+    }
+
+    // Opened before the pool, so that its workers inherit the counters
+    algo::PerfCounters perf;
+    bool hardware = counters && perf.open();
+    algo::ThreadPool threadPool(threads);
+    pool = &threadPool;
+    algo::TaskPool taskPool(threads);
+    tasks = &taskPool;
+
+    bench::Harness harness(config);
+    if (counters && algo::COUNTERS_ENABLED) {
+        harness.addProbe({{"comparisons", "moves", "max_depth", "relaxations", "heap_ops", "cells"},
+                          [] { algo::resetCounters(); },
+                          [](double* values) {
+                              algo::Counters c = algo::counters();
+                              values[0] = double(c.comparisons);
+                              values[1] = double(c.moves);
+                              values[2] = double(c.maxDepth);
+                              values[3] = double(c.relaxations);
+                              values[4] = double(c.heapOps);
+                              values[5] = double(c.cells);
+                          }});
+    } else if (counters) {
+        fprintf(stderr, "algorithm counters need a build with -DALGO_COUNTERS\n");
+    }
+    if (hardware) {
+        auto start = std::make_shared<std::vector<std::uint64_t>>(algo::PERF_EVENTS);
+        std::vector<std::string> names;
+        for (int e = 0; e < algo::PERF_EVENTS; e++)
+            names.push_back(algo::perfEventName(static_cast<algo::PerfEvent>(e)));
+        harness.addProbe({names, [&perf, start] { perf.read(start->data()); },
+                          [&perf, start](double* values) {
+                              std::uint64_t now[algo::PERF_EVENTS];
+                              perf.read(now);
+                              for (int e = 0; e < algo::PERF_EVENTS; e++)
+                                  values[e] = double(now[e] - (*start)[e]);
+                          }});
+    } else if (counters) {
+        fprintf(stderr, "hardware counters are not available here (perf_event_open)\n");
+    }
+    addSorts(harness);
+    addSearches(harness);
+    addGraphs(harness);
+    addOthers(harness);
+    harness.runAll();
+
+    if (json)
+        harness.writeJson(stdout);
+    else
+        harness.writeCsv(stdout);
+    return 0;
+}
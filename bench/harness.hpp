@@ -0,0 +1,282 @@
+// Shared benchmark harness. Replaces the clock() call around a single run
+// in every program: each case is warmed up, run repeatedly on generated
+// inputs of 10^2 .. 10^8 elements in several distributions, timed with the
+// monotonic steady_clock, and summarised as median, p99, spread and
+// throughput in CSV or JSON. Probes add event counts per run beside the
+// time, such as algorithm counters or hardware counters.
+#pragma once
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+enum class Distribution { Random, Sorted, Reverse, Duplicates };
+
+inline const char* distributionName(Distribution d)
+{
+    switch (d) {
+    case Distribution::Random: return "random";
+    case Distribution::Sorted: return "sorted";
+    case Distribution::Reverse: return "reverse";
+    case Distribution::Duplicates: return "duplicates";
+    }
+    return "?";
+}
+
+inline bool parseDistribution(const std::string& name, Distribution& d)
+{
+    for (Distribution x : {Distribution::Random, Distribution::Sorted, Distribution::Reverse, Distribution::Duplicates})
+        if (name == distributionName(x)) {
+            d = x;
+            return true;
+        }
+    return false;
+}
+
+// n keys of type T; duplicate-heavy input draws from 16 distinct values.
+template <class T = int>
+std::vector<T> generate(std::size_t n, Distribution d, std::uint64_t seed = 1)
+{
+    std::mt19937_64 rng(seed);
+    std::vector<T> data(n);
+    for (std::size_t i = 0; i < n; i++) {
+        switch (d) {
+        case Distribution::Random: data[i] = static_cast<T>(rng()); break;
+        case Distribution::Sorted: data[i] = static_cast<T>(i); break;
+        case Distribution::Reverse: data[i] = static_cast<T>(n - i); break;
+        case Distribution::Duplicates: data[i] = static_cast<T>(rng() % 16); break;
+        }
+    }
+    return data;
+}
+
+// Keep the compiler from discarding a result that is otherwise unused.
+template <class T>
+inline void doNotOptimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// One prepared input. reset() runs untimed before every repetition (for
+// example to restore the unsorted array); run() is the timed call.
+struct Runner {
+    std::function<void()> reset;
+    std::function<void()> run;
+    double items = 0; // elements processed per run(); 0 means n
+};
+
+// Counts taken around every timed run. begin() runs just before the clock
+// starts, and end() just after it stops; end() writes one value per name,
+// the count for that run.
+struct Probe {
+    std::vector<std::string> names;
+    std::function<void()> begin;
+    std::function<void(double* values)> end;
+};
+
+struct Case {
+    std::string name;
+    // Inputs this case is run on; a single entry is enough for cases that
+    // build their own input (graphs, DP tables).
+    std::vector<Distribution> distributions;
+    std::size_t maxSize; // largest n worth running (quadratic cases stop early)
+    std::function<Runner(std::size_t n, Distribution d, std::uint64_t seed)> make;
+};
+
+struct Result {
+    std::string name;
+    std::string distribution;
+    std::size_t n = 0;
+    int runs = 0;
+    double median = 0, p99 = 0, min = 0, max = 0, mean = 0, stddev = 0; // nanoseconds
+    double throughput = 0; // items per second at the median
+    std::vector<double> metrics; // median per run of each probe name, in order
+};
+
+struct Config {
+    std::size_t minSize = 100;
+    std::size_t maxSize = 100000000;
+    int warmup = 1;
+    int repetitions = 11;
+    double maxRunSeconds = 2.0; // stop growing n once one run takes this long
+    std::string filter;         // only cases whose name contains this
+    std::vector<Distribution> distributions; // empty: each case's own list
+    std::uint64_t seed = 1;
+};
+
+// Nearest-rank percentile of sorted samples.
+inline double percentile(const std::vector<double>& sorted, double p)
+{
+    std::size_t rank = static_cast<std::size_t>(std::ceil(p / 100.0 * sorted.size()));
+    return sorted[std::min(sorted.size(), std::max<std::size_t>(rank, 1)) - 1];
+}
+
+inline Result summarise(const std::string& name, Distribution d, std::size_t n, std::vector<double> samples, double items)
+{
+    Result r;
+    r.name = name;
+    r.distribution = distributionName(d);
+    r.n = n;
+    r.runs = static_cast<int>(samples.size());
+    std::sort(samples.begin(), samples.end());
+    r.min = samples.front();
+    r.max = samples.back();
+    std::size_t k = samples.size();
+    r.median = k % 2 ? samples[k / 2] : (samples[k / 2 - 1] + samples[k / 2]) / 2;
+    r.p99 = percentile(samples, 99);
+    double sum = 0;
+    for (double s : samples)
+        sum += s;
+    r.mean = sum / k;
+    double var = 0;
+    for (double s : samples)
+        var += (s - r.mean) * (s - r.mean);
+    r.stddev = k > 1 ? std::sqrt(var / (k - 1)) : 0;
+    r.throughput = r.median > 0 ? items / (r.median * 1e-9) : 0;
+    return r;
+}
+
+class Harness {
+public:
+    explicit Harness(Config config = Config()) : config_(config) {}
+
+    void add(Case c) { cases_.push_back(std::move(c)); }
+    void addProbe(Probe p) { probes_.push_back(std::move(p)); }
+
+    const std::vector<Result>& results() const { return results_; }
+
+    // Run every case that matches the filter; results are also printed to
+    // stderr as they come in.
+    void runAll()
+    {
+        for (const Case& c : cases_) {
+            if (!config_.filter.empty() && c.name.find(config_.filter) == std::string::npos)
+                continue;
+            std::vector<Distribution> dists = c.distributions;
+            if (!config_.distributions.empty()) {
+                dists.clear();
+                for (Distribution d : c.distributions)
+                    if (std::find(config_.distributions.begin(), config_.distributions.end(), d) !=
+                        config_.distributions.end())
+                        dists.push_back(d);
+            }
+            for (Distribution d : dists)
+                runCase(c, d);
+        }
+    }
+
+    void writeCsv(FILE* out) const
+    {
+        fprintf(out, "algorithm,distribution,n,runs,median_ns,p99_ns,min_ns,max_ns,mean_ns,stddev_ns,items_per_s");
+        for (const std::string& name : metricNames())
+            fprintf(out, ",%s", name.c_str());
+        fprintf(out, "\n");
+        for (const Result& r : results_) {
+            fprintf(out, "%s,%s,%zu,%d,%.0f,%.0f,%.0f,%.0f,%.0f,%.0f,%.6g", r.name.c_str(), r.distribution.c_str(), r.n,
+                    r.runs, r.median, r.p99, r.min, r.max, r.mean, r.stddev, r.throughput);
+            for (double v : r.metrics)
+                fprintf(out, ",%.0f", v);
+            fprintf(out, "\n");
+        }
+    }
+
+    void writeJson(FILE* out) const
+    {
+        const std::vector<std::string> names = metricNames();
+        fprintf(out, "[\n");
+        for (std::size_t i = 0; i < results_.size(); i++) {
+            const Result& r = results_[i];
+            fprintf(out,
+                    "  {\"algorithm\": \"%s\", \"distribution\": \"%s\", \"n\": %zu, \"runs\": %d, "
+                    "\"median_ns\": %.0f, \"p99_ns\": %.0f, \"min_ns\": %.0f, \"max_ns\": %.0f, "
+                    "\"mean_ns\": %.0f, \"stddev_ns\": %.0f, \"items_per_s\": %.6g",
+                    r.name.c_str(), r.distribution.c_str(), r.n, r.runs, r.median, r.p99, r.min, r.max, r.mean,
+                    r.stddev, r.throughput);
+            for (std::size_t k = 0; k < r.metrics.size(); k++)
+                fprintf(out, ", \"%s\": %.0f", names[k].c_str(), r.metrics[k]);
+            fprintf(out, "}%s\n", i + 1 < results_.size() ? "," : "");
+        }
+        fprintf(out, "]\n");
+    }
+
+private:
+    std::vector<std::string> metricNames() const
+    {
+        std::vector<std::string> names;
+        for (const Probe& p : probes_)
+            names.insert(names.end(), p.names.begin(), p.names.end());
+        return names;
+    }
+
+    // metrics receives one value per probe name
+    double timeOnce(const Runner& runner, double* metrics) const
+    {
+        if (runner.reset)
+            runner.reset();
+        for (const Probe& p : probes_)
+            p.begin();
+        auto start = std::chrono::steady_clock::now();
+        runner.run();
+        auto end = std::chrono::steady_clock::now();
+        for (const Probe& p : probes_) {
+            p.end(metrics);
+            metrics += p.names.size();
+        }
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+    void runCase(const Case& c, Distribution d)
+    {
+        std::size_t top = std::min(config_.maxSize, c.maxSize);
+        for (std::size_t n = config_.minSize; n <= top; n *= 10) {
+            Runner runner = c.make(n, d, config_.seed);
+            const std::vector<std::string> labels = metricNames();
+            const std::size_t names = labels.size();
+            // counts[k * repetitions + i]: name k in repetition i
+            std::vector<double> counts(names * config_.repetitions), scratch(names);
+            for (int i = 0; i < config_.warmup; i++)
+                timeOnce(runner, scratch.data());
+
+            std::vector<double> samples;
+            for (int i = 0; i < config_.repetitions; i++) {
+                samples.push_back(timeOnce(runner, scratch.data()));
+                for (std::size_t k = 0; k < names; k++)
+                    counts[k * config_.repetitions + i] = scratch[k];
+            }
+
+            results_.push_back(summarise(c.name, d, n, samples, runner.items > 0 ? runner.items : double(n)));
+            Result& r = results_.back();
+            for (std::size_t k = 0; k < names; k++) {
+                auto first = counts.begin() + static_cast<std::ptrdiff_t>(k * config_.repetitions);
+                auto mid = first + config_.repetitions / 2;
+                std::nth_element(first, mid, first + config_.repetitions);
+                r.metrics.push_back(*mid);
+            }
+            fprintf(stderr, "%-28s %-10s n=%-10zu median %12.0f ns  p99 %12.0f ns  %.3g items/s", r.name.c_str(),
+                    r.distribution.c_str(), r.n, r.median, r.p99, r.throughput);
+            for (std::size_t k = 0; k < names; k++)
+                if (r.metrics[k] != 0)
+                    fprintf(stderr, "  %s %.3g", labels[k].c_str(), r.metrics[k]);
+            fprintf(stderr, "\n");
+
+            if (r.median * 1e-9 > config_.maxRunSeconds || n > top / 10)
+                break;
+        }
+    }
+
+    Config config_;
+    std::vector<Case> cases_;
+    std::vector<Probe> probes_;
+    std::vector<Result> results_;
+};
+
+} // namespace bench
@@ -0,0 +1,435 @@
+// The algorithms from the PDF programs, ported as-is minus the scanf/printf
+// and with the stack VLAs and fixed MAX/9x9 arrays moved to the heap, so
+// the benchmark can compare every new version against its original.
+#pragma once
+
+#include <stdlib.h>
+
+#include <vector>
+
+namespace original {
+
+// Binary Search.pdf
+inline int binarySearch(const int arr[], int n, int key)
+{
+    int low = 0;
+    int high = n - 1;
+    while (low <= high) {
+        int mid = (high + low) / 2;
+        if (arr[mid] == key)
+            return mid;
+        else if (arr[mid] < key)
+            low = mid + 1;
+        else
+            high = mid - 1;
+    }
+    return -1;
+}
+
+// BinarySearchRecursive.pdf
+inline int recursiveBinarySearch(const int arr[], int low, int high, int key)
+{
+    if (low > high)
+        return -1;
+    int mid = low + (high - low) / 2;
+    if (arr[mid] == key)
+        return mid;
+    else if (arr[mid] > key)
+        return recursiveBinarySearch(arr, low, mid - 1, key);
+    else
+        return recursiveBinarySearch(arr, mid + 1, high, key);
+}
+
+// Linear Search.pdf; returns the 1-based position printed by the program, or 0
+inline int linearSearch(const int arr[], int n, int c)
+{
+    for (int i = 0; i < n; i++)
+        if (arr[i] == c)
+            return i + 1;
+    return 0;
+}
+
+// InsertionSort.pdf
+inline void insertionSort(int array[], int n)
+{
+    int i, element, j;
+    for (i = 1; i < n; i++) {
+        element = array[i];
+        j = i - 1;
+        while (j >= 0 && array[j] > element) {
+            array[j + 1] = array[j];
+            j = j - 1;
+        }
+        array[j + 1] = element;
+    }
+}
+
+// MergeSort.pdf
+inline void merge(int arr[], int left, int mid, int right)
+{
+    int i, j, k;
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+    int* L = (int*)malloc(n1 * sizeof(int));
+    int* R = (int*)malloc(n2 * sizeof(int));
+    for (i = 0; i < n1; i++)
+        L[i] = arr[left + i];
+    for (j = 0; j < n2; j++)
+        R[j] = arr[mid + 1 + j];
+    i = 0;
+    j = 0;
+    k = left;
+    while (i < n1 && j < n2) {
+        if (L[i] <= R[j])
+            arr[k++] = L[i++];
+        else
+            arr[k++] = R[j++];
+    }
+    while (i < n1)
+        arr[k++] = L[i++];
+    while (j < n2)
+        arr[k++] = R[j++];
+    free(L);
+    free(R);
+}
+
+inline void mergeSort(int arr[], int left, int right)
+{
+    if (left < right) {
+        int mid = left + (right - left) / 2;
+        mergeSort(arr, left, mid);
+        mergeSort(arr, mid + 1, right);
+        merge(arr, left, mid, right);
+    }
+}
+
+// QuickSort.pdf
+inline int partition(int arr[], int low, int high)
+{
+    int pivot = arr[high];
+    int i = (low - 1);
+    for (int j = low; j <= high - 1; j++) {
+        if (arr[j] <= pivot) {
+            i++;
+            int temp = arr[i];
+            arr[i] = arr[j];
+            arr[j] = temp;
+        }
+    }
+    int temp = arr[i + 1];
+    arr[i + 1] = arr[high];
+    arr[high] = temp;
+    return (i + 1);
+}
+
+inline void quickSort(int arr[], int low, int high)
+{
+    if (low < high) {
+        int pIndex = partition(arr, low, high);
+        quickSort(arr, low, pIndex - 1);
+        quickSort(arr, pIndex + 1, high);
+    }
+}
+
+// MaxandMinArray.pdf
+struct pair {
+    int max;
+    int min;
+};
+
+inline pair maxMinDivideConquer(const int arr[], int low, int high)
+{
+    pair result, left, right;
+    if (low == high) {
+        result.max = arr[low];
+        result.min = arr[low];
+        return result;
+    }
+    if (high == low + 1) {
+        if (arr[low] < arr[high]) {
+            result.min = arr[low];
+            result.max = arr[high];
+        } else {
+            result.min = arr[high];
+            result.max = arr[low];
+        }
+        return result;
+    }
+    int mid = low + (high - low) / 2;
+    left = maxMinDivideConquer(arr, low, mid);
+    right = maxMinDivideConquer(arr, mid + 1, high);
+    result.max = left.max > right.max ? left.max : right.max;
+    result.min = left.min < right.min ? left.min : right.min;
+    return result;
+}
+
+// Knapsack.pdf, with knap[n + 1][W + 1] on the heap
+inline int knapsack(int W, const int wt[], const int val[], int n)
+{
+    std::vector<int> knap(static_cast<size_t>(n + 1) * (W + 1));
+    auto at = [&](int i, int w) -> int& { return knap[static_cast<size_t>(i) * (W + 1) + w]; };
+    for (int i = 0; i <= n; i++) {
+        for (int w = 0; w <= W; w++) {
+            if (i == 0 || w == 0)
+                at(i, w) = 0;
+            else if (wt[i - 1] <= w)
+                at(i, w) = val[i - 1] + at(i - 1, w - wt[i - 1]) > at(i - 1, w) ? val[i - 1] + at(i - 1, w - wt[i - 1])
+                                                                                 : at(i - 1, w);
+            else
+                at(i, w) = at(i - 1, w);
+        }
+    }
+    return at(n, W);
+}
+
+// LCS.pdf, with L[m + 1][n + 1] on the heap; lcs_str receives the subsequence
+inline int lcs(const char* X, const char* Y, int m, int n, std::vector<char>* lcs_str = nullptr)
+{
+    std::vector<int> L(static_cast<size_t>(m + 1) * (n + 1));
+    auto at = [&](int i, int j) -> int& { return L[static_cast<size_t>(i) * (n + 1) + j]; };
+    for (int i = 0; i <= m; i++) {
+        for (int j = 0; j <= n; j++) {
+            if (i == 0 || j == 0)
+                at(i, j) = 0;
+            else if (X[i - 1] == Y[j - 1])
+                at(i, j) = at(i - 1, j - 1) + 1;
+            else
+                at(i, j) = at(i - 1, j) > at(i, j - 1) ? at(i - 1, j) : at(i, j - 1);
+        }
+    }
+    int index = at(m, n);
+    if (lcs_str) {
+        lcs_str->assign(index + 1, '\0');
+        int i = m, j = n;
+        while (i > 0 && j > 0) {
+            if (X[i - 1] == Y[j - 1]) {
+                (*lcs_str)[index - 1] = X[i - 1];
+                i--;
+                j--;
+                index--;
+            } else if (at(i - 1, j) > at(i, j - 1)) {
+                i--;
+            } else {
+                j--;
+            }
+        }
+    }
+    return at(m, n);
+}
+
+// Dijikstra's Algorithm.pdf, on an n x n row-major matrix instead of G[MAX][MAX]
+const int INFINITY_COST = 9999;
+
+inline void dijkstra(const int* G, int n, int startnode, int* distance, int* pred)
+{
+    std::vector<int> cost(static_cast<size_t>(n) * n), visited(n);
+    int count, mindistance, nextnode = startnode, i, j;
+    for (i = 0; i < n; i++)
+        for (j = 0; j < n; j++)
+            cost[(size_t)i * n + j] = G[(size_t)i * n + j] == 0 ? INFINITY_COST : G[(size_t)i * n + j];
+    for (i = 0; i < n; i++) {
+        distance[i] = cost[(size_t)startnode * n + i];
+        pred[i] = startnode;
+        visited[i] = 0;
+    }
+    distance[startnode] = 0;
+    visited[startnode] = 1;
+    count = 1;
+    while (count < n - 1) {
+        mindistance = INFINITY_COST;
+        for (i = 0; i < n; i++)
+            if (distance[i] < mindistance && !visited[i]) {
+                mindistance = distance[i];
+                nextnode = i;
+            }
+        visited[nextnode] = 1;
+        for (i = 0; i < n; i++)
+            if (!visited[i])
+                if (mindistance + cost[(size_t)nextnode * n + i] < distance[i]) {
+                    distance[i] = mindistance + cost[(size_t)nextnode * n + i];
+                    pred[i] = nextnode;
+                }
+        count++;
+    }
+}
+
+// Kruskal's Algorithm.pdf: 1-based n x n cost matrix (row stride n + 1),
+// 0 meaning no edge; returns mincost
+inline int kruskal(std::vector<int> cost, int n)
+{
+    std::vector<int> parent(n + 1, 0);
+    auto at = [&](int i, int j) -> int& { return cost[(size_t)i * (n + 1) + j]; };
+    auto find = [&](int i) {
+        while (parent[i])
+            i = parent[i];
+        return i;
+    };
+    int a = 0, b = 0, u = 0, v = 0, ne = 1, min, mincost = 0;
+    for (int i = 1; i <= n; i++)
+        for (int j = 1; j <= n; j++)
+            if (at(i, j) == 0)
+                at(i, j) = 999;
+    while (ne < n) {
+        min = 999;
+        for (int i = 1; i <= n; i++)
+            for (int j = 1; j <= n; j++)
+                if (at(i, j) < min) {
+                    min = at(i, j);
+                    a = u = i;
+                    b = v = j;
+                }
+        if (min == 999)
+            break; // disconnected; the original loops forever here
+        u = find(u);
+        v = find(v);
+        if (u != v) {
+            parent[v] = u;
+            ne++;
+            mincost += min;
+        }
+        at(a, b) = at(b, a) = 999;
+    }
+    return mincost;
+}
+
+// Fibonacci Series.pdf; returns the last term instead of printing each one
+inline int fibonacciSeries(int n)
+{
+    int t1 = 0, t2 = 1, nextterm = 1;
+    for (int i = 3; i <= n; i++) {
+        nextterm = t1 + t2;
+        t1 = t2;
+        t2 = nextterm;
+    }
+    return nextterm;
+}
+
+// SubsetSum.pdf; counts the subsets instead of printing them
+inline void findSubset(const int set[], int subset[], int n, int index, int target, int currentSum, long long& found)
+{
+    if (currentSum == target) {
+        found++;
+        return;
+    }
+    if (currentSum > target || n == 0)
+        return;
+    subset[index] = set[0];
+    findSubset(set + 1, subset, n - 1, index + 1, target, currentSum + set[0], found);
+    findSubset(set + 1, subset, n - 1, index, target, currentSum, found);
+}
+
+// Miller-Rabin Test.pdf
+inline long long power_mod(long long base, long long exp, long long mod)
+{
+    long long result = 1;
+    base = base % mod;
+    while (exp > 0) {
+        if (exp % 2 == 1)
+            result = (result * base) % mod;
+        exp = exp >> 1;
+        base = (base * base) % mod;
+    }
+    return result;
+}
+
+inline int miller_rabin_test(long long n, long long d)
+{
+    long long a = 2 + rand() % (n - 4);
+    long long x = power_mod(a, d, n);
+    if (x == 1 || x == n - 1)
+        return 1;
+    while (d != n - 1) {
+        x = (x * x) % n;
+        d *= 2;
+        if (x == 1)
+            return 0;
+        if (x == n - 1)
+            return 1;
+    }
+    return 0;
+}
+
+inline int is_prime(long long n, int k)
+{
+    if (n <= 1 || n == 4)
+        return 0;
+    if (n <= 3)
+        return 1;
+    long long d = n - 1;
+    while (d % 2 == 0)
+        d /= 2;
+    for (int i = 0; i < k; i++)
+        if (!miller_rabin_test(n, d))
+            return 0;
+    return 1;
+}
+
+// NQueens.pdf with a runtime N; board is N x N row-major
+inline bool isSafe(const std::vector<int>& board, int N, int row, int col)
+{
+    for (int i = 0; i < col; ++i)
+        if (board[row * N + i])
+            return false;
+    for (int i = row, j = col; i >= 0 && j >= 0; --i, --j)
+        if (board[i * N + j])
+            return false;
+    for (int i = row, j = col; i < N && j >= 0; ++i, --j)
+        if (board[i * N + j])
+            return false;
+    return true;
+}
+
+inline bool solveNQUtil(std::vector<int>& board, int N, int col)
+{
+    if (col >= N)
+        return true;
+    for (int i = 0; i < N; ++i) {
+        if (isSafe(board, N, i, col)) {
+            board[i * N + col] = 1;
+            if (solveNQUtil(board, N, col + 1))
+                return true;
+            board[i * N + col] = 0;
+        }
+    }
+    return false;
+}
+
+// Fractional Knapsack.pdf, without the per-item printf
+struct Item {
+    int itemId;
+    int weight;
+    int profit;
+    float pByw;
+};
+
+inline int compareItems(const void* a, const void* b)
+{
+    const Item* itemA = (const Item*)a;
+    const Item* itemB = (const Item*)b;
+    if (itemA->pByw < itemB->pByw)
+        return 1;
+    if (itemA->pByw > itemB->pByw)
+        return -1;
+    return 0;
+}
+
+inline float fractionalKnapsack(Item* items, int n, int capacity)
+{
+    qsort(items, n, sizeof(Item), compareItems);
+    float totalProfit = 0.0;
+    int currentWeight = 0;
+    for (int i = 0; i < n; i++) {
+        if (currentWeight + items[i].weight <= capacity) {
+            currentWeight += items[i].weight;
+            totalProfit += items[i].profit;
+        } else {
+            float remainingCapacity = capacity - currentWeight;
+            float fraction = remainingCapacity / items[i].weight;
+            totalProfit += fraction * items[i].profit;
+            break;
+        }
+    }
+    return totalProfit;
+}
+
+} // namespace original
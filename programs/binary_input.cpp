@@ -0,0 +1,105 @@
+// Text input versus the mapped binary container. Writes a random graph of n
+// vertices and 4n edges as dijkstra_heap's text input, then reads it back
+// three ways: fscanf one number at a time like the original programs,
+// parseInts() on one thread, and parseInts() across threads. The graph is
+// converted to the binary container, mapped, and Dijkstra runs on the
+// mapping in place. The result is checked against the graph built from the
+// text.
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "algorithms/binary_file.hpp"
+#include "algorithms/dijkstra.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    int n;
+    unsigned threads;
+    printf("Enter no. of vertices and threads (0 = all): ");
+    if (scanf("%d %u", &n, &threads) != 2 || n <= 0)
+        return 1;
+    char textPath[] = "/tmp/binary_input_XXXXXX";
+    char binaryPath[] = "/tmp/binary_input_XXXXXX";
+    int textFd = mkstemp(textPath), binaryFd = mkstemp(binaryPath);
+    if (textFd < 0 || binaryFd < 0) {
+        perror("mkstemp");
+        return 1;
+    }
+    close(textFd);
+    close(binaryFd);
+
+    std::mt19937_64 rng(12345);
+    const long long m = 4LL * n;
+    std::string text = std::to_string(n) + ' ' + std::to_string(m) + '\n';
+    for (long long i = 0; i < m; i++)
+        text += std::to_string(rng() % n) + ' ' + std::to_string(rng() % n) + ' ' +
+                std::to_string(1 + rng() % 100) + '\n';
+    FILE* f = fopen(textPath, "w");
+    bool ok = f && fwrite(text.data(), 1, text.size(), f) == text.size();
+    ok = f && fclose(f) == 0 && ok;
+    if (!ok) {
+        perror(textPath);
+        return 1;
+    }
+    printf("%zu bytes of text\n", text.size());
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<int> scanned;
+    f = fopen(textPath, "r");
+    for (int x; f && fscanf(f, "%d", &x) == 1;)
+        scanned.push_back(x);
+    if (f)
+        fclose(f);
+    printf("%-12s Execution time: %f seconds\n", "fscanf", secondsSince(start));
+
+    std::vector<int> single, parallel;
+    algo::MappedFile mapped;
+    algo::ThreadPool pool(threads);
+    ok = mapped.open(textPath, true);
+    start = std::chrono::steady_clock::now();
+    ok = ok && algo::parseInts(mapped.data(), mapped.size(), single);
+    printf("%-12s Execution time: %f seconds\n", "parseInts", secondsSince(start));
+    start = std::chrono::steady_clock::now();
+    ok = ok && algo::parseInts(mapped.data(), mapped.size(), parallel, &pool);
+    printf("%-12s Execution time: %f seconds (%u threads)\n", "parallel", secondsSince(start), pool.size());
+    ok = ok && scanned == single && scanned == parallel;
+
+    std::vector<algo::Edge> edges(static_cast<std::size_t>(m));
+    for (std::size_t i = 0; i < edges.size(); i++)
+        edges[i] = {parallel[2 + 3 * i], parallel[3 + 3 * i], parallel[4 + 3 * i]};
+    algo::CsrGraph g = algo::buildCsr(n, edges);
+    ok = ok && algo::writeBinaryGraph(binaryPath, g);
+
+    start = std::chrono::steady_clock::now();
+    algo::BinaryFile binary;
+    std::string error;
+    if (!binary.open(binaryPath, &error)) {
+        fprintf(stderr, "%s: %s\n", binaryPath, error.c_str());
+        return 1;
+    }
+    printf("%-12s Execution time: %f seconds\n", "map", secondsSince(start));
+
+    std::vector<long long> distance, expected;
+    std::vector<int> pred, expectedPred;
+    start = std::chrono::steady_clock::now();
+    algo::dijkstra(binary.graph(), 0, distance, pred);
+    printf("%-12s Execution time: %f seconds (on the mapping)\n", "dijkstra", secondsSince(start));
+    algo::dijkstra(g, 0, expected, expectedPred);
+    ok = ok && binary.validateGraph() && distance == expected && pred == expectedPred;
+
+    unlink(textPath);
+    unlink(binaryPath);
+    printf("Result: %s\n", ok ? "consistent" : "MISMATCH");
+    return ok ? 0 : 1;
+}
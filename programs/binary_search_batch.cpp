@@ -0,0 +1,74 @@
+// Looks up a batch of random keys in one large sorted table: one
+// binarySearch() per key against the lockstep batch, on the plain table and
+// the Eytzinger index, across threads, and the merge mode once the keys are
+// sorted.
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "algorithms/search_batch.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    int n;
+    std::size_t queries;
+    unsigned threads;
+    printf("Enter the table size, number of lookups and threads (0 = all): ");
+    if (scanf("%d %zu %u", &n, &queries, &threads) != 3 || n < 1 || n > (1 << 30))
+        return 1;
+
+    // 0, 2, 4, ..: odd keys are misses
+    std::vector<int> arr(n);
+    for (int i = 0; i < n; i++)
+        arr[i] = 2 * i;
+    std::mt19937_64 rng(12345);
+    std::vector<int> keys(queries);
+    for (int& k : keys)
+        k = static_cast<int>(rng() % (2 * static_cast<unsigned long long>(n)));
+    algo::EytzingerIndex eytzinger(arr.data(), n);
+    algo::ThreadPool pool(threads);
+
+    std::vector<int> expected(queries), results(queries);
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t q = 0; q < queries; q++)
+        expected[q] = algo::binarySearch(arr.data(), n, keys[q]);
+    printf("%-24s Execution time: %f seconds\n", "one key at a time", secondsSince(start));
+
+    bool ok = true;
+    auto time = [&](const char* name, auto batch) {
+        std::fill(results.begin(), results.end(), -2);
+        auto began = std::chrono::steady_clock::now();
+        batch();
+        printf("%-24s Execution time: %f seconds\n", name, secondsSince(began));
+        ok = ok && results == expected;
+    };
+    time("binarySearchBatch", [&] { algo::binarySearchBatch(arr.data(), n, keys.data(), queries, results.data()); });
+    time("  parallel", [&] { algo::binarySearchBatch(arr.data(), n, keys.data(), queries, results.data(), &pool); });
+    time("findBatch (Eytzinger)", [&] { algo::findBatch(eytzinger, keys.data(), queries, results.data()); });
+    time("  parallel", [&] { algo::findBatch(eytzinger, keys.data(), queries, results.data(), &pool); });
+
+    std::sort(keys.begin(), keys.end());
+    for (std::size_t q = 0; q < queries; q++)
+        expected[q] = algo::binarySearch(arr.data(), n, keys[q]);
+    time("sorted keys, merged", [&] {
+        algo::binarySearchSortedBatch(arr.data(), n, keys.data(), queries, results.data());
+    });
+    time("  parallel", [&] {
+        algo::binarySearchSortedBatch(arr.data(), n, keys.data(), queries, results.data(), &pool);
+    });
+
+    std::size_t found = 0;
+    for (int r : results)
+        found += r != -1;
+    printf("%zu of %zu keys found (%u threads)\n", found, queries, pool.size());
+    printf("Result: %s\n", ok ? "consistent" : "MISMATCH");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+// Binary search on a large sorted table: finds the original program's key,
+// then times the branchless binarySearch(), the Eytzinger index and the
+// S-tree on the same random keys, half of them missing, and checks every
+// answer against std::lower_bound.
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "algorithms/search_index.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    int n, queries;
+    printf("Enter the table size and number of lookups: ");
+    if (scanf("%d %d", &n, &queries) != 2 || n < 1 || queries < 1 || n > (1 << 30))
+        return 1;
+
+    // 0, 2, 4, ..: odd keys are misses
+    std::vector<int> arr(n);
+    for (int i = 0; i < n; i++)
+        arr[i] = 2 * i;
+    std::mt19937_64 rng(12345);
+    std::vector<int> keys(queries);
+    for (int& k : keys)
+        k = static_cast<int>(rng() % (2 * static_cast<unsigned long long>(n)));
+
+    auto start = std::chrono::steady_clock::now();
+    algo::EytzingerIndex eytzinger(arr.data(), n);
+    algo::STreeIndex stree(arr.data(), n);
+    printf("%-16s Execution time: %f seconds\n", "build indexes", secondsSince(start));
+
+    int key = 2 * (n - 1);
+    int result = stree.find(key);
+    if (result != -1)
+        printf("Element found at index %d\n", result);
+    else
+        printf("Element not found\n");
+
+    std::vector<int> expected(queries);
+    start = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++) {
+        auto at = std::lower_bound(arr.begin(), arr.end(), keys[q]);
+        expected[q] = at != arr.end() && *at == keys[q] ? static_cast<int>(at - arr.begin()) : -1;
+    }
+    printf("%-16s Execution time: %f seconds\n", "std::lower_bound", secondsSince(start));
+
+    bool ok = result == n - 1;
+    auto time = [&](const char* name, auto search) {
+        std::vector<int> found(queries);
+        auto began = std::chrono::steady_clock::now();
+        for (int q = 0; q < queries; q++)
+            found[q] = search(keys[q]);
+        printf("%-16s Execution time: %f seconds\n", name, secondsSince(began));
+        ok = ok && found == expected;
+    };
+    time("binarySearch", [&](int k) { return algo::binarySearch(arr.data(), n, k); });
+    time("EytzingerIndex", [&](int k) { return eytzinger.find(k); });
+    time("STreeIndex", [&](int k) { return stree.find(k); });
+
+    printf("Result: %s\n", ok ? "consistent" : "MISMATCH");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+// Convex hull of the original program's ten points, keeping the points on
+// hull edges as its brute-force base case does, then of N random points,
+// sequentially and on a TaskPool.
+#include <stdio.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "algorithms/convex_hull.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    std::vector<algo::Point> a = {{0, 0},   {1, -4},  {-1, -5}, {-5, -3}, {-3, -1},
+                                  {-1, -3}, {-2, -2}, {-1, -1}, {-2, -1}, {-1, 1}};
+    auto start = std::chrono::steady_clock::now();
+    std::vector<algo::Point> hull = algo::convexHull(a, nullptr, true);
+    double elapsed = secondsSince(start);
+    printf("Convex hull:\n");
+    for (const algo::Point& p : hull)
+        printf("%d %d\n", p.x, p.y);
+    printf("%f is the execution time\n", elapsed);
+
+    std::size_t n;
+    unsigned threads;
+    printf("\nEnter N and threads (0 = all): ");
+    if (scanf("%zu %u", &n, &threads) != 2 || n == 0)
+        return 1;
+    std::mt19937_64 rng(12345);
+    std::vector<algo::Point> points(n);
+    for (algo::Point& p : points)
+        p = {static_cast<int>(rng()), static_cast<int>(rng())};
+    algo::TaskPool pool(threads);
+
+    std::vector<algo::Point> work = points;
+    std::vector<algo::Point> sequential(n + 1), parallel(n + 1);
+    start = std::chrono::steady_clock::now();
+    sequential.resize(algo::convexHull(work.data(), n, sequential.data()));
+    printf("%-12s Execution time: %f seconds\n", "sequential", secondsSince(start));
+    work = points;
+    start = std::chrono::steady_clock::now();
+    parallel.resize(algo::convexHull(work.data(), n, parallel.data(), pool));
+    printf("%-12s Execution time: %f seconds (%u threads)\n", "parallel", secondsSince(start), pool.size());
+
+    printf("%zu hull vertices\n", sequential.size());
+    bool ok = sequential == parallel;
+    printf("Result: %s\n", ok ? "consistent" : "MISMATCH");
+    return ok ? 0 : 1;
+}
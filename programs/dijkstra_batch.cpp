@@ -0,0 +1,57 @@
+// Answers a batch of start nodes on one random graph with dijkstraBatch()
+// and compares the time against calling dijkstra() once per start node.
+#include <stdio.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "algorithms/dijkstra.hpp"
+#include "algorithms/sssp_batch.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    int n, m, queries, threads;
+
+    printf("Enter no. of vertices, edges, start nodes and threads (0 = all):");
+    if (scanf("%d %d %d %d", &n, &m, &queries, &threads) != 4 || n <= 0 || m < 0 || queries < 0)
+        return 1;
+
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> node(0, n - 1), weight(1, 100);
+    std::vector<algo::Edge> edges(m);
+    for (algo::Edge& e : edges)
+        e = {node(rng), node(rng), weight(rng)};
+    algo::CsrGraph g = algo::buildCsr(n, edges);
+
+    std::vector<int> sources(queries);
+    for (int& s : sources)
+        s = node(rng);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<long long> distance;
+    std::vector<int> pred;
+    bool match = true;
+    algo::ThreadPool pool(threads);
+    algo::BatchShortestPaths batch = algo::dijkstraBatch(g, sources, true, &pool);
+    double batched = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++) {
+        algo::dijkstra(g, sources[q], distance, pred);
+        for (int v = 0; v < n; v++)
+            if (batch.distanceRow(q)[v] != distance[v] || batch.predRow(q)[v] != pred[v])
+                match = false;
+    }
+    double single = secondsSince(start);
+
+    printf("\nOne dijkstra() per start node: %f seconds\n", single);
+    printf("dijkstraBatch (%u threads): %f seconds\n", pool.size(), batched);
+    printf("Results %s\n", match ? "match" : "DIFFER");
+    return match ? 0 : 1;
+}
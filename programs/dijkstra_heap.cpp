@@ -0,0 +1,57 @@
+// Dijkstra's algorithm over an edge list using the CSR graph and binary heap
+// from algorithms/dijkstra.hpp, and reports the execution time.
+#include <stdio.h>
+#include <time.h>
+
+#include <vector>
+
+#include "algorithms/dijkstra.hpp"
+
+int main()
+{
+    int n, m, u;
+    clock_t start, end;
+    double cpu_time_used;
+
+    printf("Enter no. of vertices and edges:");
+    if (scanf("%d %d", &n, &m) != 2 || n <= 0)
+        return 1;
+
+    std::vector<algo::Edge> edges(m);
+    printf("\nEnter the edges (from to weight):\n");
+    for (int i = 0; i < m; i++)
+        if (scanf("%d %d %d", &edges[i].u, &edges[i].v, &edges[i].w) != 3)
+            return 1;
+
+    printf("\nEnter the starting node:");
+    if (scanf("%d", &u) != 1 || u < 0 || u >= n)
+        return 1;
+
+    start = clock();
+    algo::CsrGraph g = algo::buildCsr(n, edges);
+    std::vector<long long> distance;
+    std::vector<int> pred;
+    algo::dijkstra(g, u, distance, pred);
+    end = clock();
+
+    // print the path and distance of each node
+    for (int i = 0; i < n; i++) {
+        if (i == u)
+            continue;
+        if (distance[i] == algo::INFINITY_DIST) {
+            printf("\nDistance of node%d=unreachable", i);
+            continue;
+        }
+        printf("\nDistance of node%d=%lld", i, distance[i]);
+        printf("\nPath=%d", i);
+        int j = i;
+        do {
+            j = pred[j];
+            printf("<-%d", j);
+        } while (j != u);
+    }
+
+    cpu_time_used = ((double)(end - start)) / CLOCKS_PER_SEC;
+    printf("\nExecution time:%f seconds\n", cpu_time_used);
+    return 0;
+}
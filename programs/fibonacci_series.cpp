@@ -0,0 +1,65 @@
+// Fibonacci series: prints the first n terms like the original program, now
+// exact past the 46th term and written with one fwrite. Then computes F(index)
+// by fast doubling, single-threaded and across threads, and checks it against
+// fibonacciMod() and the series' last term.
+#include <stdio.h>
+
+#include <chrono>
+#include <cinttypes>
+#include <string>
+
+#include "algorithms/fibonacci.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    std::size_t n;
+    printf("Enter the number of terms: ");
+    if (scanf("%zu", &n) != 1)
+        return 1;
+    // The original prints the first two terms whatever n is
+    const std::size_t terms = n < 2 ? 2 : n;
+    auto start = std::chrono::steady_clock::now();
+    std::string text = "Fibonacci Series: ";
+    algo::appendFibonacciSeries(terms, text);
+    fwrite(text.data(), 1, text.size(), stdout);
+    printf("\nExecution Time: %f seconds\n", secondsSince(start));
+
+    std::uint64_t index, m;
+    unsigned threads;
+    printf("\nEnter an index, a modulus and threads (0 = all): ");
+    if (scanf("%" SCNu64 " %" SCNu64 " %u", &index, &m, &threads) != 3 || m == 0)
+        return 1;
+    start = std::chrono::steady_clock::now();
+    algo::BigUnsigned f = algo::fibonacciBig(index);
+    printf("%-12s Execution time: %f seconds\n", "fastDoubling", secondsSince(start));
+    algo::ThreadPool pool(threads);
+    start = std::chrono::steady_clock::now();
+    algo::BigUnsigned parallel = algo::fibonacciBig(index, &pool);
+    printf("%-12s Execution time: %f seconds (%u threads)\n", "parallel", secondsSince(start), pool.size());
+    start = std::chrono::steady_clock::now();
+    std::uint64_t residue = algo::fibonacciMod(index, m);
+    printf("%-12s Execution time: %f seconds\n", "mod", secondsSince(start));
+
+    const std::string digits = f.toString();
+    if (digits.size() <= 40)
+        printf("F(%" PRIu64 ") = %s\n", index, digits.c_str());
+    else
+        printf("F(%" PRIu64 ") = %.20s...%s (%zu digits)\n", index, digits.c_str(),
+               digits.c_str() + digits.size() - 20, digits.size());
+    printf("F(%" PRIu64 ") mod %" PRIu64 " = %" PRIu64 "\n", index, m, residue);
+
+    // The series ends in "F(terms - 1) "
+    const std::string last = algo::fibonacciBig(terms - 1).toString() + ' ';
+    bool ok = f == parallel && f.mod(m) == residue && text.size() >= last.size() &&
+              text.compare(text.size() - last.size(), last.size(), last) == 0 &&
+              text[text.size() - last.size() - 1] == ' ';
+    if (index <= algo::FIBONACCI_MAX_EXACT)
+        ok = ok && digits == std::to_string(algo::fibonacci(index));
+    printf("Result: %s\n", ok ? "consistent" : "MISMATCH");
+    return ok ? 0 : 1;
+}
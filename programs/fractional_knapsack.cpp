@@ -0,0 +1,111 @@
+// Fractional knapsack: reads items and a capacity like the original
+// program, solves in partial-sort mode and prints the same log of the items
+// taken, after the timed solve. Then times selection and partial sort on N
+// random items, and a batch of random problems, against each other.
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "algorithms/fractional_knapsack.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    int n, knapsackCapacity;
+    printf("Enter the number of items: ");
+    if (scanf("%d", &n) != 1 || n < 0)
+        return 1;
+    std::vector<int> itemId(n), weight(n), profit(n);
+    printf("Enter itemId, weight, and profit for each item:\n");
+    for (int i = 0; i < n; i++) {
+        printf("Item %d: ", i + 1);
+        if (scanf("%d %d %d", &itemId[i], &weight[i], &profit[i]) != 3 || weight[i] <= 0)
+            return 1;
+    }
+    printf("Enter the knapsack capacity: ");
+    if (scanf("%d", &knapsackCapacity) != 1)
+        return 1;
+
+    algo::FractionalKnapsack solver;
+    auto start = std::chrono::steady_clock::now();
+    algo::FractionalSolution s = solver.solve({weight.data(), profit.data(), static_cast<std::size_t>(n)},
+                                              knapsackCapacity, algo::FractionalMode::PartialSort);
+    double elapsed = secondsSince(start);
+    long long currentWeight = 0, totalProfit = 0;
+    for (std::size_t k = 0; k < s.whole; k++) {
+        std::size_t i = solver.takenItem(k);
+        currentWeight += weight[i];
+        totalProfit += profit[i];
+        printf("Added item %d (Weight: %d, Profit: %d) completely. Current weight: %lld, Total profit: %.2f\n",
+               itemId[i], weight[i], profit[i], currentWeight, static_cast<double>(totalProfit));
+    }
+    if (s.split < static_cast<std::size_t>(n))
+        printf("Added %.2f%% of item %d (Weight: %d, Profit: %d). Current weight: %d, Total profit: %.2f\n",
+               s.fraction * 100, itemId[s.split], weight[s.split], profit[s.split], knapsackCapacity, s.profit);
+    printf("\nMaximum profit for the given capacity: %.2f\n", s.profit);
+    printf("Execution time: %f seconds\n", elapsed);
+
+    std::size_t bigN;
+    unsigned threads;
+    printf("\nEnter the number of random items and threads (0 = all): ");
+    if (scanf("%zu %u", &bigN, &threads) != 2 || bigN == 0)
+        return 1;
+    std::mt19937_64 rng(12345);
+    std::vector<int> bigWeight(bigN), bigProfit(bigN);
+    long long total = 0;
+    for (std::size_t i = 0; i < bigN; i++) {
+        bigWeight[i] = static_cast<int>(1 + rng() % 100);
+        bigProfit[i] = static_cast<int>(1 + rng() % 1000);
+        total += bigWeight[i];
+    }
+    const algo::FractionalItems items = {bigWeight.data(), bigProfit.data(), bigN};
+    start = std::chrono::steady_clock::now();
+    double selected = solver.solve(items, total / 10).profit;
+    printf("%-14s Execution time: %f seconds\n", "select", secondsSince(start));
+    start = std::chrono::steady_clock::now();
+    double sorted = solver.solve(items, total / 10, algo::FractionalMode::PartialSort).profit;
+    printf("%-14s Execution time: %f seconds\n", "partial sort", secondsSince(start));
+    printf("Maximum profit: %.2f\n", selected);
+    bool ok = std::fabs(selected - sorted) <= 1e-9 * selected;
+
+    // The same items as 1024-item problems, each with a tenth of its weight
+    const std::size_t width = 1024;
+    std::vector<algo::FractionalProblem> problems;
+    for (std::size_t lo = 0; lo < bigN; lo += width) {
+        std::size_t m = std::min(width, bigN - lo);
+        long long w = 0;
+        for (std::size_t i = lo; i < lo + m; i++)
+            w += bigWeight[i];
+        problems.push_back({{bigWeight.data() + lo, bigProfit.data() + lo, m}, w / 10});
+    }
+    std::vector<algo::FractionalSolution> single(problems.size()), parallel(problems.size());
+    algo::ThreadPool pool(threads);
+    start = std::chrono::steady_clock::now();
+    algo::fractionalKnapsackBatch(problems.data(), problems.size(), single.data());
+    printf("%-14s Execution time: %f seconds (%zu problems)\n", "batch", secondsSince(start), problems.size());
+    start = std::chrono::steady_clock::now();
+    algo::fractionalKnapsackBatch(problems.data(), problems.size(), parallel.data(), &pool);
+    printf("%-14s Execution time: %f seconds (%u threads)\n", "batch parallel", secondsSince(start), pool.size());
+    for (std::size_t p = 0; p < problems.size(); p++)
+        ok = ok && single[p].profit == parallel[p].profit;
+
+    // The same batch with the taken items sorted, as the original lists them
+    for (algo::FractionalProblem& p : problems)
+        p.mode = algo::FractionalMode::PartialSort;
+    start = std::chrono::steady_clock::now();
+    algo::fractionalKnapsackBatch(problems.data(), problems.size(), parallel.data(), &pool);
+    printf("%-14s Execution time: %f seconds (%u threads)\n", "batch sorted", secondsSince(start), pool.size());
+    for (std::size_t p = 0; p < problems.size(); p++)
+        ok = ok && std::fabs(single[p].profit - parallel[p].profit) <= 1e-9 * single[p].profit;
+
+    printf("Result: %s\n", ok ? "consistent" : "MISMATCH");
+    return ok ? 0 : 1;
+}
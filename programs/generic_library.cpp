@@ -0,0 +1,103 @@
+// The library through its generic front-ends and one umbrella include. It
+// runs the original programs' inputs as vectors, strings and std::arrays
+// passed as Spans, with comparators, plus the compile-time NQueens<N> and
+// sorting networks. Then it times the compile-time-sized variants against
+// their runtime-sized counterparts.
+#include <stdio.h>
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "algorithms/algo.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Sorted by the eight-input network during compilation
+constexpr std::array<int, 8> sortedAtCompileTime()
+{
+    std::array<int, 8> a = {64, 34, 25, 12, 22, 11, 90, 5};
+    algo::networkSort(a);
+    return a;
+}
+
+static_assert(sortedAtCompileTime()[0] == 5 && sortedAtCompileTime()[7] == 90, "compile-time network sort");
+static_assert(algo::NQueens<8>::count() == 92, "compile-time 8-queens count");
+
+const int FIXED_QUEENS = 12;
+
+int main()
+{
+    // Knapsack.pdf and LCS.pdf, on containers
+    std::vector<int> val = {60, 100, 120}, wt = {10, 20, 30};
+    printf("The maximum value that can be put in the knapsack is: %lld\n", algo::knapsack(50, wt, val));
+    std::string X = "AGGTAB", Y = "GXTXAYB";
+    printf("Length of LCS is %d\n", algo::lcsLength(algo::span(X), algo::span(Y)));
+    std::vector<std::string> a = {"the", "quick", "brown", "fox", "jumps", "over", "the", "lazy", "dog"};
+    std::vector<std::string> b = {"the", "lazy", "brown", "dog", "jumps", "over", "the", "fox"};
+    printf("Length of the word LCS is %d\n", algo::lcsLength(algo::span(a), algo::span(b)));
+
+    // Stable sort by length, then binary search by the same comparator
+    auto shorter = [](const std::string& x, const std::string& y) { return x.size() < y.size(); };
+    algo::mergeSort(algo::span(a), shorter);
+    printf("By length:");
+    for (const std::string& word : a)
+        printf(" %s", word.c_str());
+    std::ptrdiff_t four = algo::binarySearch(algo::span(a), std::string(4, '?'), shorter);
+    printf("\nFirst four-letter word: %s\n", four >= 0 ? a[four].c_str() : "none");
+
+    std::array<int, 8> board;
+    algo::NQueens<8>::first(board);
+    printf("8-queens rows by column:");
+    for (int row : board)
+        printf(" %d", row);
+    constexpr std::array<int, 8> sorted = sortedAtCompileTime();
+    printf("\nSorted at compile time:");
+    for (int x : sorted)
+        printf(" %d", x);
+    printf("\n");
+
+    std::size_t blocks;
+    printf("\nEnter the number of 16-element blocks to sort: ");
+    if (scanf("%zu", &blocks) != 1)
+        return 1;
+    std::mt19937_64 rng(12345);
+    std::vector<std::array<int, 16>> input(blocks);
+    for (std::array<int, 16>& block : input)
+        for (int& x : block)
+            x = static_cast<int>(rng() >> 33);
+
+    std::vector<std::array<int, 16>> fixed = input, sized = input, insertion = input;
+    auto start = std::chrono::steady_clock::now();
+    for (std::array<int, 16>& block : fixed)
+        algo::networkSort(block);
+    printf("%-16s Execution time: %f seconds\n", "network<16>", secondsSince(start));
+    start = std::chrono::steady_clock::now();
+    for (std::array<int, 16>& block : sized)
+        algo::networkSort(block.data(), block.size());
+    printf("%-16s Execution time: %f seconds\n", "network(n)", secondsSince(start));
+    start = std::chrono::steady_clock::now();
+    for (std::array<int, 16>& block : insertion)
+        algo::insertionSort(algo::span(block));
+    printf("%-16s Execution time: %f seconds\n", "insertionSort", secondsSince(start));
+
+    // An optimising build may fold this call into a constant
+    start = std::chrono::steady_clock::now();
+    long long fixedCount = algo::NQueens<FIXED_QUEENS>::count();
+    printf("%-16s Execution time: %f seconds\n", "NQueens<12>", secondsSince(start));
+    start = std::chrono::steady_clock::now();
+    long long count = algo::nQueensCount(FIXED_QUEENS);
+    printf("%-16s Execution time: %f seconds\n", "nQueensCount(12)", secondsSince(start));
+    printf("%lld solutions\n", count);
+
+    bool ok = fixed == sized && fixed == insertion && fixedCount == count &&
+              algo::lcsLength(algo::span(X), algo::span(Y), std::equal_to<char>()) == 4;
+    printf("Result: %s\n", ok ? "consistent" : "MISMATCH");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,52 @@
+// Streaming convex hull: starts from the original program's ten points, then
+// feeds N random points into an IncrementalHull one at a time, with a
+// point-in-hull query after every insert. The final hull is checked against
+// convexHull() over all the points at once.
+#include <stdio.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "algorithms/incremental_hull.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    std::vector<algo::Point> points = {{0, 0},   {1, -4},  {-1, -5}, {-5, -3}, {-3, -1},
+                                       {-1, -3}, {-2, -2}, {-1, -1}, {-2, -1}, {-1, 1}};
+    algo::IncrementalHull hull(points);
+    printf("Convex hull:\n");
+    hull.forEachVertex([](const algo::Point& p) { printf("%d %d\n", p.x, p.y); });
+
+    std::size_t n;
+    printf("\nEnter the number of points to stream: ");
+    if (scanf("%zu", &n) != 1)
+        return 1;
+    std::mt19937_64 rng(12345);
+    std::uniform_int_distribution<int> coordinate(-1000000, 1000000);
+    std::size_t changed = 0, inside = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < n; i++) {
+        algo::Point p = {coordinate(rng), coordinate(rng)};
+        points.push_back(p);
+        changed += hull.insert(p);
+        inside += hull.contains({coordinate(rng), coordinate(rng)});
+    }
+    double elapsed = secondsSince(start);
+    printf("%zu inserts changed the hull, %zu of %zu queries inside\n", changed, inside, n);
+    printf("%-12s Execution time: %f seconds\n", "incremental", elapsed);
+
+    start = std::chrono::steady_clock::now();
+    std::vector<algo::Point> expected = algo::convexHull(points);
+    printf("%-12s Execution time: %f seconds (once)\n", "convexHull", secondsSince(start));
+
+    printf("%zu hull vertices\n", hull.hull().size());
+    bool ok = hull.hull() == expected;
+    printf("Result: %s\n", ok ? "consistent" : "MISMATCH");
+    return ok ? 0 : 1;
+}
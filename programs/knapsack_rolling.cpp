@@ -0,0 +1,77 @@
+// 0/1 Knapsack with a single rolling DP row. Solves the sample from the
+// original program, lists the chosen items, then times both reconstruction
+// modes and the bitset feasibility mode on a larger random instance whose
+// knap[n + 1][W + 1] table would not fit on the stack.
+#include <stdio.h>
+#include <time.h>
+
+#include <random>
+#include <vector>
+
+#include "algorithms/knapsack.hpp"
+
+static void printItems(const algo::KnapsackSolution& s, const int wt[], const int val[])
+{
+    for (int i : s.items)
+        printf("  item %d: weight %d, value %d\n", i + 1, wt[i], val[i]);
+}
+
+int main()
+{
+    clock_t start, end;
+    double cpu_time_used;
+    int val[] = {60, 100, 120}; // Values of items
+    int wt[] = {10, 20, 30};    // Weights of items
+    int W = 50;                 // Maximum capacity of the knapsack
+    int n = sizeof(val) / sizeof(val[0]);
+
+    start = clock();
+    algo::KnapsackSolution s = algo::knapsackWithItems(W, wt, val, n);
+    end = clock();
+    printf("The maximum value that can be put in the knapsack is: %lld\n", s.value);
+    printItems(s, wt, val);
+    printf("Heaviest exact fill: %lld\n", algo::knapsackMaxFill(W, wt, n));
+    cpu_time_used = ((double)(end - start) / CLOCKS_PER_SEC);
+    printf("Execution time: %f seconds\n", cpu_time_used);
+
+    const int bigN = 1000, bigW = 100000;
+    std::mt19937 rng(12345);
+    std::vector<int> bigWt(bigN), bigVal(bigN);
+    for (int i = 0; i < bigN; i++) {
+        bigWt[i] = 1 + static_cast<int>(rng() % 1000);
+        bigVal[i] = 1 + static_cast<int>(rng() % 1000);
+    }
+    printf("\n%d random items, capacity %d\n", bigN, bigW);
+
+    start = clock();
+    long long best = algo::knapsack(bigW, bigWt.data(), bigVal.data(), bigN);
+    end = clock();
+    printf("%-16s value %lld  Execution time: %f seconds\n", "value only", best,
+           (double)(end - start) / CLOCKS_PER_SEC);
+
+    bool ok = true;
+    const algo::KnapsackReconstruction modes[] = {algo::KnapsackReconstruction::Bitmap,
+                                                  algo::KnapsackReconstruction::DivideAndConquer};
+    const char* names[] = {"bitmap", "divide+conquer"};
+    for (int m = 0; m < 2; m++) {
+        start = clock();
+        algo::KnapsackSolution big = algo::knapsackWithItems(bigW, bigWt.data(), bigVal.data(), bigN, modes[m]);
+        end = clock();
+        long long weight = 0, value = 0;
+        for (int i : big.items) {
+            weight += bigWt[i];
+            value += bigVal[i];
+        }
+        ok = ok && big.value == best && value == best && weight <= bigW;
+        printf("%-16s value %lld, %zu items  Execution time: %f seconds\n", names[m], big.value, big.items.size(),
+               (double)(end - start) / CLOCKS_PER_SEC);
+    }
+
+    start = clock();
+    long long fill = algo::knapsackMaxFill(bigW, bigWt.data(), bigN);
+    end = clock();
+    printf("%-16s fill %lld  Execution time: %f seconds\n", "bitset", fill, (double)(end - start) / CLOCKS_PER_SEC);
+
+    printf("Result: %s\n", ok ? "consistent" : "MISMATCH");
+    return ok ? 0 : 1;
+}
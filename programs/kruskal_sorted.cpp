@@ -0,0 +1,47 @@
+// Kruskal's algorithm over an edge list with a radix-sorted edge array and
+// a path-halving, union-by-rank disjoint set. Prints the MST edges, the
+// minimum cost and the CPU time.
+#include <stdio.h>
+#include <time.h>
+
+#include <vector>
+
+#include "algorithms/kruskal.hpp"
+
+int main()
+{
+    int n, m;
+    clock_t start, end;
+    double cpu_time_used;
+
+    printf("Kruskal's algorithm in C\n");
+    printf("========================\n");
+
+    printf("Enter the no. of vertices and edges:\n");
+    if (scanf("%d %d", &n, &m) != 2 || n <= 0 || m < 0)
+        return 1;
+
+    // Vertices are numbered from 1 as in the original program
+    std::vector<algo::Edge> edges(m);
+    printf("\nEnter the edges (from to cost):\n");
+    for (algo::Edge& e : edges) {
+        if (scanf("%d %d %d", &e.u, &e.v, &e.w) != 3 || e.u < 1 || e.u > n || e.v < 1 || e.v > n)
+            return 1;
+        e.u--;
+        e.v--;
+    }
+
+    start = clock();
+    algo::MstResult mst = algo::kruskal(n, edges);
+    end = clock();
+
+    printf("The edges of Minimum Cost Spanning Tree are\n");
+    int ne = 1;
+    for (const algo::Edge& e : mst.edges)
+        printf("%d edge (%d,%d) =%d\n", ne++, e.u + 1, e.v + 1, e.w);
+
+    printf("\nMinimum cost = %lld\n", mst.mincost);
+    cpu_time_used = ((double)(end - start)) / CLOCKS_PER_SEC;
+    printf("Execution time:%f\n", cpu_time_used);
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Linear search over a large unsorted column. The column is N random ints,
+// or the ints of the file given as the first argument, memory-mapped. Finds
+// the first position of c like the original program, counts every
+// occurrence, and times the scalar, SIMD and multithreaded scans.
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "algorithms/linear_search.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<int> generated;
+    const int* arr = nullptr;
+    std::size_t n = 0;
+    void* mapped = MAP_FAILED;
+    if (argc > 1) {
+        int fd = open(argv[1], O_RDONLY);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) != 0) {
+            perror(argv[1]);
+            return 1;
+        }
+        n = static_cast<std::size_t>(st.st_size) / sizeof(int);
+        if (n > 0)
+            mapped = mmap(nullptr, n * sizeof(int), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED) {
+            fprintf(stderr, "%s: nothing to map\n", argv[1]);
+            return 1;
+        }
+        arr = static_cast<const int*>(mapped);
+        printf("Mapped %zu elements from %s\n", n, argv[1]);
+    } else {
+        printf("Enter N: ");
+        if (scanf("%zu", &n) != 1)
+            return 1;
+        std::mt19937_64 rng(12345);
+        generated.resize(n);
+        for (int& x : generated)
+            x = static_cast<int>(rng() % 1000000);
+        arr = generated.data();
+    }
+
+    int c;
+    unsigned threads;
+    printf("Enter Search element c and threads (0 = all): ");
+    if (scanf("%d %u", &c, &threads) != 2)
+        return 1;
+    algo::ThreadPool pool(threads);
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t position = algo::linearSearch(arr, n, c);
+    double elapsed = secondsSince(start);
+    if (position)
+        printf("Element %d found in position %zu\n", c, position);
+    else
+        printf("Element %d not found\n", c);
+    printf("Execution time: %.6f Seconds\n", elapsed);
+
+    const std::size_t first = position ? position - 1 : n;
+    std::size_t count = algo::countEqual(arr, n, c, algo::ScanKernel::Scalar);
+    bool ok = true;
+    const struct {
+        const char* name;
+        algo::ScanKernel kernel;
+    } kernels[] = {{"scalar", algo::ScanKernel::Scalar},
+                   {"AVX2", algo::ScanKernel::Avx2},
+                   {"AVX-512", algo::ScanKernel::Avx512}};
+    for (const auto& k : kernels) {
+        if (!algo::scanKernelSupported(k.kernel))
+            continue;
+        start = std::chrono::steady_clock::now();
+        ok = ok && algo::findFirst(arr, n, c, k.kernel) == first;
+        double findTime = secondsSince(start);
+        start = std::chrono::steady_clock::now();
+        ok = ok && algo::countEqual(arr, n, c, k.kernel) == count;
+        printf("%-8s find %.6f s, count %.6f s\n", k.name, findTime, secondsSince(start));
+    }
+    start = std::chrono::steady_clock::now();
+    ok = ok && algo::findFirst(arr, n, c, pool) == first;
+    double findTime = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    ok = ok && algo::countEqual(arr, n, c, pool) == count;
+    printf("%-8s find %.6f s, count %.6f s (%u threads)\n", "parallel", findTime, secondsSince(start), pool.size());
+
+    printf("%zu occurrences of %d\n", count, c);
+    printf("Result: %s\n", ok ? "consistent" : "MISMATCH");
+    if (mapped != MAP_FAILED)
+        munmap(mapped, n * sizeof(int));
+    return ok ? 0 : 1;
+}
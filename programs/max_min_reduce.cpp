@@ -0,0 +1,73 @@
+// Max and min of an array: the original sample through
+// maxMinDivideConquer(), then a large random column through the pairwise
+// scan, the SIMD kernels and the parallel split, and the generic reduce()
+// for argmin, argmax and sum.
+#include <stdio.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "algorithms/reduce.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    int arr[] = {6, 4, 26, 14, 33, 64, 46};
+    int n = sizeof(arr) / sizeof(arr[0]);
+    auto start = std::chrono::steady_clock::now();
+    algo::MinMax<int> result = algo::maxMinDivideConquer(arr, 0, n - 1);
+    double elapsed = secondsSince(start);
+    printf("Maximum element: %d\n", result.max);
+    printf("Minimum element: %d\n", result.min);
+    printf("Execution time: %.6f seconds\n", elapsed);
+
+    std::size_t size;
+    unsigned threads;
+    printf("\nEnter the size of the large array and threads (0 = all): ");
+    if (scanf("%zu %u", &size, &threads) != 2 || size == 0)
+        return 1;
+    std::mt19937_64 rng(12345);
+    std::vector<int> column(size);
+    for (int& x : column)
+        x = static_cast<int>(rng());
+    algo::TaskPool pool(threads);
+
+    start = std::chrono::steady_clock::now();
+    algo::MinMax<int> expected = algo::minMaxPairwise(column.data(), size);
+    printf("%-16s Execution time: %.6f seconds\n", "pairwise", secondsSince(start));
+    bool ok = true;
+    const struct {
+        const char* name;
+        algo::ReduceKernel kernel;
+    } kernels[] = {{"AVX2", algo::ReduceKernel::Avx2}, {"AVX-512", algo::ReduceKernel::Avx512}};
+    for (const auto& k : kernels) {
+        if (!algo::reduceKernelSupported(k.kernel))
+            continue;
+        start = std::chrono::steady_clock::now();
+        algo::MinMax<int> r = algo::minMax(column.data(), size, nullptr, k.kernel);
+        printf("%-16s Execution time: %.6f seconds\n", k.name, secondsSince(start));
+        ok = ok && r.min == expected.min && r.max == expected.max;
+    }
+    start = std::chrono::steady_clock::now();
+    algo::MinMax<int> parallel = algo::minMax(column.data(), size, &pool);
+    printf("%-16s Execution time: %.6f seconds (%u threads)\n", "parallel", secondsSince(start), pool.size());
+    ok = ok && parallel.min == expected.min && parallel.max == expected.max;
+    printf("Maximum element: %d\nMinimum element: %d\n", expected.max, expected.min);
+
+    start = std::chrono::steady_clock::now();
+    algo::ArgResult<int> lo = algo::reduce(column.data(), size, algo::ArgMinReducer<int>(), &pool);
+    algo::ArgResult<int> hi = algo::reduce(column.data(), size, algo::ArgMaxReducer<int>(), &pool);
+    long long sum = algo::reduce(column.data(), size, algo::SumReducer<int>(), &pool);
+    printf("%-16s Execution time: %.6f seconds\n", "argmin/argmax/sum", secondsSince(start));
+    printf("argmin %zu, argmax %zu, sum %lld\n", lo.index, hi.index, sum);
+    ok = ok && lo.value == expected.min && hi.value == expected.max && column[lo.index] == expected.min &&
+         column[hi.index] == expected.max;
+
+    printf("Result: %s\n", ok ? "consistent" : "MISMATCH");
+    return ok ? 0 : 1;
+}
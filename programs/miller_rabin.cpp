@@ -0,0 +1,69 @@
+// Deterministic Miller-Rabin. Checks one number like the original program,
+// now for any 64-bit n, then times isPrimeBatch() on random 64-bit odd
+// numbers one at a time, interleaved, and across threads.
+#include <stdio.h>
+#include <time.h>
+
+#include <chrono>
+#include <cinttypes>
+#include <random>
+#include <vector>
+
+#include "algorithms/miller_rabin.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    std::uint64_t n;
+    clock_t start, end;
+    double cpu_time_used;
+
+    printf("Enter a number to check if it is prime: ");
+    if (scanf("%" SCNu64, &n) != 1)
+        return 1;
+    start = clock();
+    bool prime = algo::isPrime(n);
+    end = clock();
+    if (prime)
+        printf("%" PRIu64 " is a prime number.\n", n);
+    else
+        printf("%" PRIu64 " is not a prime number.\n", n);
+    cpu_time_used = ((double)(end - start)) / CLOCKS_PER_SEC;
+    printf("Execution %f seconds\n", cpu_time_used);
+
+    std::size_t count;
+    unsigned threads;
+    printf("\nEnter how many random numbers to test and threads (0 = all): ");
+    if (scanf("%zu %u", &count, &threads) != 2)
+        return 1;
+    std::mt19937_64 rng(12345);
+    std::vector<std::uint64_t> numbers(count);
+    for (std::uint64_t& x : numbers)
+        x = rng() | 1;
+
+    std::vector<std::uint8_t> single(count), batch(count), parallel(count);
+    auto t = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count; i++)
+        single[i] = algo::isPrime(numbers[i]);
+    printf("%-12s Execution time: %f seconds\n", "isPrime", secondsSince(t));
+
+    t = std::chrono::steady_clock::now();
+    algo::isPrimeBatch(numbers.data(), count, batch.data());
+    printf("%-12s Execution time: %f seconds\n", "batch", secondsSince(t));
+
+    algo::ThreadPool pool(threads);
+    t = std::chrono::steady_clock::now();
+    algo::isPrimeBatch(numbers.data(), count, parallel.data(), &pool);
+    printf("%-12s Execution time: %f seconds (%u threads)\n", "parallel", secondsSince(t), pool.size());
+
+    std::size_t primes = 0;
+    for (std::uint8_t p : single)
+        primes += p;
+    bool ok = single == batch && single == parallel;
+    printf("%zu primes, Result: %s\n", primes, ok ? "consistent" : "MISMATCH");
+    return ok ? 0 : 1;
+}
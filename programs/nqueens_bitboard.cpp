@@ -0,0 +1,54 @@
+// N-Queens on bitboards for a runtime N: prints the board the original
+// program prints, then counts every solution sequentially and with the
+// first two columns split across threads.
+#include <stdio.h>
+
+#include <chrono>
+#include <vector>
+
+#include "algorithms/nqueens.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void printSolution(const std::vector<int>& rowOf)
+{
+    int N = static_cast<int>(rowOf.size());
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < N; ++j)
+            printf("%c ", rowOf[j] == i ? 'Q' : '.');
+        printf("\n");
+    }
+    printf("\n");
+}
+
+int main()
+{
+    int N;
+    unsigned threads;
+    printf("Enter the board size (1 .. %d) and threads (0 = all): ", algo::NQUEENS_MAX);
+    if (scanf("%d %u", &N, &threads) != 2 || N < 1 || N > algo::NQUEENS_MAX)
+        return 1;
+
+    std::vector<int> rowOf;
+    auto start = std::chrono::steady_clock::now();
+    bool found = algo::nQueensFirst(N, rowOf);
+    double elapsed = secondsSince(start);
+    if (found)
+        printSolution(rowOf);
+    else
+        printf("Solution does not exist.\n");
+    printf("First solution  Execution time: %f seconds\n", elapsed);
+
+    start = std::chrono::steady_clock::now();
+    long long count = algo::nQueensCount(N);
+    printf("%lld solutions  Execution time: %f seconds\n", count, secondsSince(start));
+
+    algo::TaskPool pool(threads);
+    start = std::chrono::steady_clock::now();
+    long long parallelCount = algo::nQueensCount(N, pool);
+    printf("%lld solutions  Execution time: %f seconds (%u threads)\n", parallelCount, secondsSince(start), pool.size());
+    return count == parallelCount ? 0 : 1;
+}
@@ -0,0 +1,78 @@
+// Which numbers in [a, b] are prime: a segmented sieve of the range,
+// sequential and across threads, against testing every number with
+// Miller-Rabin. The range is then cached, so is_prime() answers from it.
+// Last, [10^18, 10^18 + 10^5] is checked the same way; it is short next to
+// its square root, so the sieve tests it with Miller-Rabin.
+#include <stdio.h>
+
+#include <chrono>
+#include <cinttypes>
+
+#include "algorithms/prime_sieve.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    std::uint64_t a, b;
+    unsigned threads;
+    printf("Enter the range [a, b] and threads (0 = all): ");
+    if (scanf("%" SCNu64 " %" SCNu64 " %u", &a, &b, &threads) != 3 || a > b || b >= algo::SIEVE_LIMIT)
+        return 1;
+
+    auto start = std::chrono::steady_clock::now();
+    algo::SievedRange range(a, b);
+    double elapsed = secondsSince(start);
+    std::uint64_t count = range.count();
+    printf("%" PRIu64 " primes in [%" PRIu64 ", %" PRIu64 "]\n", count, a, b);
+    printf("%-14s Execution time: %f seconds\n", "sieve", elapsed);
+
+    algo::ThreadPool pool(threads);
+    start = std::chrono::steady_clock::now();
+    algo::SievedRange parallel(a, b, &pool);
+    elapsed = secondsSince(start);
+    printf("%-14s Execution time: %f seconds (%u threads)\n", "parallel sieve", elapsed, pool.size());
+    bool ok = parallel.count() == count;
+
+    if (b - a <= 10000000) {
+        std::uint64_t tested = 0;
+        start = std::chrono::steady_clock::now();
+        for (std::uint64_t n = a; n <= b; n++)
+            tested += algo::isPrime(n);
+        printf("%-14s Execution time: %f seconds\n", "Miller-Rabin", secondsSince(start));
+        ok = ok && tested == count;
+    }
+
+    printf("First primes:");
+    int shown = 0;
+    range.forEachPrime([&](std::uint64_t p) {
+        if (shown++ < 10)
+            printf(" %" PRIu64, p);
+    });
+    printf("\n");
+
+    algo::primeCache().sieve(a, b, &pool);
+    std::uint64_t cached = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::uint64_t n = a; n <= b && n - a < 10000000; n++)
+        cached += algo::is_prime(static_cast<long long>(n), 5);
+    printf("%-14s Execution time: %f seconds\n", "cached is_prime", secondsSince(start));
+    ok = ok && (b - a >= 10000000 || cached == count);
+
+    const std::uint64_t highLo = 1000000000000000000ull, highHi = highLo + 100000;
+    start = std::chrono::steady_clock::now();
+    algo::SievedRange high(highLo, highHi, &pool);
+    elapsed = secondsSince(start);
+    std::uint64_t highTested = 0;
+    for (std::uint64_t n = highLo; n <= highHi; n++)
+        highTested += algo::isPrime(n);
+    printf("%" PRIu64 " primes in [%" PRIu64 ", %" PRIu64 "]\n", high.count(), highLo, highHi);
+    printf("%-14s Execution time: %f seconds\n", "high range", elapsed);
+    ok = ok && high.count() == highTested;
+
+    printf("Result: %s\n", ok ? "consistent" : "MISMATCH");
+    return ok ? 0 : 1;
+}
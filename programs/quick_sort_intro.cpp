@@ -0,0 +1,79 @@
+// Introsort-style Quick Sort: sorts the original sample array, times random,
+// sorted, reverse-sorted and duplicate-heavy inputs of a given size, then
+// times quickSortInt() on each partition kernel the CPU supports.
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "algorithms/quick_sort.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void printArray(const int arr[], int size)
+{
+    for (int i = 0; i < size; i++)
+        printf("%d ", arr[i]);
+    printf("\n");
+}
+
+int main()
+{
+    int arr[] = {10, 7, 8, 9, 1, 5};
+    int n = sizeof(arr) / sizeof(arr[0]);
+
+    printf("Array:\n");
+    printArray(arr, n);
+    algo::quickSort(arr, n);
+    printf("\nSorted:\n");
+    printArray(arr, n);
+
+    std::size_t size;
+    printf("\nEnter the size of the large arrays: ");
+    if (scanf("%zu", &size) != 1)
+        return 1;
+
+    std::mt19937 rng(12345);
+    const char* names[] = {"random", "sorted", "reverse", "duplicates"};
+    bool ok = true;
+    for (int kind = 0; kind < 4; kind++) {
+        std::vector<int> data(size);
+        for (std::size_t i = 0; i < size; i++) {
+            switch (kind) {
+            case 0: data[i] = static_cast<int>(rng()); break;
+            case 1: data[i] = static_cast<int>(i); break;
+            case 2: data[i] = static_cast<int>(size - i); break;
+            default: data[i] = static_cast<int>(rng() % 16); break;
+            }
+        }
+        auto start = std::chrono::steady_clock::now();
+        algo::quickSort(data.data(), size);
+        double elapsed = secondsSince(start);
+        ok = ok && std::is_sorted(data.begin(), data.end());
+        printf("%-10s Execution time: %.6f seconds\n", names[kind], elapsed);
+    }
+
+    std::vector<int> input(size);
+    for (int& x : input)
+        x = static_cast<int>(rng());
+    const algo::PartitionKernel kernels[] = {algo::PartitionKernel::Scalar, algo::PartitionKernel::Block,
+                                             algo::PartitionKernel::Avx2, algo::PartitionKernel::Avx512};
+    const char* kernelNames[] = {"scalar", "block", "avx2", "avx512"};
+    for (int k = 0; k < 4; k++) {
+        if (!algo::partitionKernelSupported(kernels[k]))
+            continue;
+        std::vector<int> data = input;
+        auto start = std::chrono::steady_clock::now();
+        algo::quickSortInt(data.data(), size, kernels[k]);
+        double elapsed = secondsSince(start);
+        ok = ok && std::is_sorted(data.begin(), data.end());
+        printf("%-10s Execution time: %.6f seconds\n", kernelNames[k], elapsed);
+    }
+    printf("Result: %s\n", ok ? "sorted" : "NOT SORTED");
+    return ok ? 0 : 1;
+}
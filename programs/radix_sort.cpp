@@ -0,0 +1,60 @@
+// LSD Radix Sort next to the comparison sorts: times radixSort(),
+// parallelRadixSort(), quickSortInt() and mergeSort() on the same random
+// 32-bit keys, then radixSort() on 64-bit keys.
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "algorithms/merge_sort.hpp"
+#include "algorithms/quick_sort.hpp"
+#include "algorithms/radix_sort.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    std::size_t n;
+    unsigned threads;
+    printf("Enter the number of keys and threads (0 = all): ");
+    if (scanf("%zu %u", &n, &threads) != 2)
+        return 1;
+
+    std::mt19937_64 rng(12345);
+    std::vector<int> input(n);
+    for (int& x : input)
+        x = static_cast<int>(rng());
+
+    algo::ThreadPool pool(threads);
+    bool ok = true;
+    auto time = [&](const char* name, auto sort) {
+        std::vector<int> data = input;
+        auto start = std::chrono::steady_clock::now();
+        sort(data.data());
+        double elapsed = secondsSince(start);
+        ok = ok && std::is_sorted(data.begin(), data.end());
+        printf("%-22s Execution time: %.6f seconds\n", name, elapsed);
+    };
+    time("radixSort", [&](int* a) { algo::radixSort(a, n); });
+    time("parallelRadixSort", [&](int* a) { algo::parallelRadixSort(a, n, pool); });
+    time("quickSortInt", [&](int* a) { algo::quickSortInt(a, n); });
+    time("mergeSort", [&](int* a) { algo::mergeSort(a, n); });
+
+    std::vector<std::int64_t> wide(n);
+    for (std::int64_t& x : wide)
+        x = static_cast<std::int64_t>(rng());
+    auto start = std::chrono::steady_clock::now();
+    algo::radixSort(wide.data(), n);
+    double elapsed = secondsSince(start);
+    ok = ok && std::is_sorted(wide.begin(), wide.end());
+    printf("%-22s Execution time: %.6f seconds\n", "radixSort (64-bit)", elapsed);
+
+    printf("Result: %s\n", ok ? "sorted" : "NOT SORTED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+// The sorts compared by cause as well as by time. It sorts the same input
+// with each variant and prints, next to the time, the comparisons, moves
+// and recursion depth the kernels counted, with the hardware events the
+// kernel allows. Build with -DALGO_COUNTERS for the algorithm counts;
+// without it they read 0 and the sorts are the uninstrumented code.
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "algorithms/counters.hpp"
+#include "algorithms/merge_sort.hpp"
+#include "algorithms/quick_sort.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    std::size_t n;
+    printf("Enter the size of the array: ");
+    if (scanf("%zu", &n) != 1)
+        return 1;
+    std::mt19937_64 rng(12345);
+    std::vector<int> input(n);
+    for (int& x : input)
+        x = static_cast<int>(rng() >> 33);
+    std::vector<int> expected = input;
+    std::sort(expected.begin(), expected.end());
+
+    algo::PerfCounters perf;
+    bool hardware = perf.open();
+    if (!algo::COUNTERS_ENABLED)
+        printf("Built without -DALGO_COUNTERS: algorithm counts are 0\n");
+    if (!hardware)
+        printf("Hardware counters are not available (perf_event_open)\n");
+
+    struct Variant {
+        const char* name;
+        std::function<void(int*, std::size_t)> sort;
+    };
+    const Variant variants[] = {
+        {"quickSort", [](int* a, std::size_t k) { algo::quickSort(a, k); }},
+        {"quickSortInt", [](int* a, std::size_t k) { algo::quickSortInt(a, k); }},
+        {"mergeSort", [](int* a, std::size_t k) { algo::mergeSort(a, k); }},
+        {"heapSort", [](int* a, std::size_t k) { algo::heapSort(a, k); }},
+    };
+
+    printf("%-14s %10s %14s %14s %6s", "", "seconds", "comparisons", "moves", "depth");
+    if (hardware)
+        printf(" %14s %14s %12s %12s", "cycles", "instructions", "llc_misses", "br_misses");
+    printf("\n");
+    bool ok = true;
+    for (const Variant& v : variants) {
+        std::vector<int> a = input;
+        std::uint64_t before[algo::PERF_EVENTS], after[algo::PERF_EVENTS];
+        algo::resetCounters();
+        perf.read(before);
+        auto start = std::chrono::steady_clock::now();
+        v.sort(a.data(), a.size());
+        double seconds = secondsSince(start);
+        perf.read(after);
+        algo::Counters c = algo::counters();
+        ok = ok && a == expected;
+
+        printf("%-14s %10.6f %14llu %14llu %6llu", v.name, seconds, static_cast<unsigned long long>(c.comparisons),
+               static_cast<unsigned long long>(c.moves), static_cast<unsigned long long>(c.maxDepth));
+        if (hardware)
+            printf(" %14llu %14llu %12llu %12llu", static_cast<unsigned long long>(after[0] - before[0]),
+                   static_cast<unsigned long long>(after[1] - before[1]),
+                   static_cast<unsigned long long>(after[2] - before[2]),
+                   static_cast<unsigned long long>(after[3] - before[3]));
+        printf("\n");
+    }
+    printf("Result: %s\n", ok ? "consistent" : "MISMATCH");
+    return ok ? 0 : 1;
+}
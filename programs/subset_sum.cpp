@@ -0,0 +1,69 @@
+// Subset sum with the pruned enumeration, the bitset DP and meet in the
+// middle. Reads the set and target like the original program and prints
+// every subset through the findSubsets() callback, then checks a set with
+// zero elements.
+#include <stdio.h>
+#include <time.h>
+
+#include <vector>
+
+#include "algorithms/subset_sum.hpp"
+
+int main()
+{
+    int n, target;
+    clock_t start, end;
+    double cpu_time_used;
+    printf("Enter the number of elements in the set: ");
+    if (scanf("%d", &n) != 1 || n < 0)
+        return 1;
+    std::vector<int> set(n);
+    printf("Enter the elements of the set: ");
+    for (int i = 0; i < n; i++)
+        if (scanf("%d", &set[i]) != 1 || set[i] < 0)
+            return 1;
+    printf("Enter the target sum: ");
+    if (scanf("%d", &target) != 1)
+        return 1;
+
+    printf("Subsets with sum %d:\n", target);
+    start = clock();
+    long long found = algo::findSubsets(set.data(), n, target, [](const int* subset, int size) {
+        printf("Subset found: ");
+        for (int i = 0; i < size; i++)
+            printf("%d ", subset[i]);
+        printf("\n");
+    });
+    end = clock();
+    cpu_time_used = ((double)(end - start)) / CLOCKS_PER_SEC;
+    printf("%lld subsets, Execution time: %f seconds\n", found, cpu_time_used);
+
+    start = clock();
+    bool reachable = algo::subsetSumReachable(set.data(), n, target);
+    end = clock();
+    printf("Bitset DP: %s, Execution time: %f seconds\n", reachable ? "reachable" : "not reachable",
+           ((double)(end - start)) / CLOCKS_PER_SEC);
+
+    bool ok = reachable == (found > 0);
+    if (n <= algo::SUBSET_SUM_MITM_MAX) {
+        std::vector<long long> wide(set.begin(), set.end());
+        start = clock();
+        algo::SubsetSumCount count = algo::subsetSumMeetInMiddle(wide.data(), n, target);
+        end = clock();
+        printf("Meet in the middle: %lld subsets, Execution time: %f seconds\n", count.count,
+               ((double)(end - start)) / CLOCKS_PER_SEC);
+        ok = ok && count.count == found;
+    }
+
+    // Self-check with zero elements: each matching subset of the others
+    // appears once per choice of the zeros
+    const int zeros[] = {0, 3, 0, 1, 2};
+    const long long zerosWide[] = {0, 3, 0, 1, 2};
+    long long zeroFound = algo::findSubsets(zeros, 5, 3, [](const int*, int) {});
+    long long zeroCount = algo::subsetSumMeetInMiddle(zerosWide, 5, 3).count;
+    long long onlyZero = algo::findSubsets(zeros, 1, 0, [](const int*, int) {});
+    printf("Zero elements: %lld and %lld subsets, expected 8\n", zeroFound, zeroCount);
+    ok = ok && zeroFound == 8 && zeroCount == 8 && onlyZero == 2;
+    printf("Result: %s\n", ok ? "consistent" : "MISMATCH");
+    return ok ? 0 : 1;
+}
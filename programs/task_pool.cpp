@@ -0,0 +1,139 @@
+// The recursive algorithms on one work-stealing TaskPool: quick and merge
+// sort, min/max, the convex hull, N-Queens and subset sum, each timed next
+// to its sequential version. The last run sorts several arrays in parallel,
+// each with the parallel sort on the same pool, which a ThreadPool cannot
+// nest, and then loops on one pool from inside the tasks of another.
+#include <stdio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "algorithms/convex_hull.hpp"
+#include "algorithms/merge_sort.hpp"
+#include "algorithms/nqueens.hpp"
+#include "algorithms/quick_sort.hpp"
+#include "algorithms/reduce.hpp"
+#include "algorithms/subset_sum.hpp"
+#include "algorithms/task_pool.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+    std::size_t n;
+    unsigned threads;
+    printf("Enter the size of the array and threads (0 = all): ");
+    if (scanf("%zu %u", &n, &threads) != 2 || n == 0)
+        return 1;
+    std::mt19937_64 rng(12345);
+    std::vector<int> input(n);
+    for (int& x : input)
+        x = static_cast<int>(rng());
+    algo::TaskPool tasks(threads);
+    printf("%u workers\n", tasks.size());
+    bool ok = true;
+
+    std::vector<int> expected = input;
+    auto start = std::chrono::steady_clock::now();
+    algo::quickSort(expected.data(), n);
+    printf("%-24s Execution time: %f seconds\n", "quickSort", secondsSince(start));
+    std::vector<int> a = input;
+    start = std::chrono::steady_clock::now();
+    algo::parallelQuickSort(a.data(), n, tasks);
+    printf("%-24s Execution time: %f seconds\n", "quickSort/tasks", secondsSince(start));
+    ok = ok && a == expected;
+
+    a = input;
+    start = std::chrono::steady_clock::now();
+    algo::mergeSort(a.data(), n);
+    printf("%-24s Execution time: %f seconds\n", "mergeSort", secondsSince(start));
+    ok = ok && a == expected;
+    a = input;
+    start = std::chrono::steady_clock::now();
+    algo::parallelMergeSort(a.data(), n, tasks);
+    printf("%-24s Execution time: %f seconds\n", "mergeSort/tasks", secondsSince(start));
+    ok = ok && a == expected;
+
+    start = std::chrono::steady_clock::now();
+    algo::MinMax<int> range = algo::minMax(input.data(), n);
+    printf("%-24s Execution time: %f seconds\n", "minMax", secondsSince(start));
+    start = std::chrono::steady_clock::now();
+    algo::MinMax<int> forked = algo::maxMinDivideConquer(input.data(), 0, static_cast<int>(n) - 1, &tasks);
+    printf("%-24s Execution time: %f seconds\n", "minMax/tasks", secondsSince(start));
+    ok = ok && range.min == expected.front() && range.max == expected.back() && forked.min == range.min &&
+         forked.max == range.max;
+
+    std::vector<algo::Point> points(n);
+    for (algo::Point& p : points)
+        p = {static_cast<int>(rng() % 2000001) - 1000000, static_cast<int>(rng() % 2000001) - 1000000};
+    start = std::chrono::steady_clock::now();
+    std::vector<algo::Point> hull = algo::convexHull(points);
+    printf("%-24s Execution time: %f seconds\n", "convexHull", secondsSince(start));
+    std::vector<algo::Point> hullTasks(n + 1);
+    start = std::chrono::steady_clock::now();
+    hullTasks.resize(algo::convexHull(points.data(), n, hullTasks.data(), tasks));
+    printf("%-24s Execution time: %f seconds\n", "convexHull/tasks", secondsSince(start));
+    ok = ok && hull == hullTasks;
+
+    const int queens = 13;
+    start = std::chrono::steady_clock::now();
+    long long solutions = algo::nQueensCount(queens);
+    printf("%-24s Execution time: %f seconds\n", "nQueensCount", secondsSince(start));
+    start = std::chrono::steady_clock::now();
+    long long solutionsTasks = algo::nQueensCount(queens, tasks);
+    printf("%-24s Execution time: %f seconds\n", "nQueensCount/tasks", secondsSince(start));
+    printf("%d-Queens: %lld solutions\n", queens, solutionsTasks);
+    ok = ok && solutions == solutionsTasks;
+
+    std::vector<int> set(28);
+    for (int& x : set)
+        x = 1 + static_cast<int>(rng() % 60);
+    const int target = 200;
+    start = std::chrono::steady_clock::now();
+    long long subsets = algo::findSubsets(set.data(), static_cast<int>(set.size()), target, [](const int*, int) {});
+    printf("%-24s Execution time: %f seconds\n", "findSubsets", secondsSince(start));
+    std::atomic<long long> reported{0};
+    start = std::chrono::steady_clock::now();
+    long long subsetsTasks = algo::findSubsets(set.data(), static_cast<int>(set.size()), target, tasks,
+                                               [&](const int*, int) { reported.fetch_add(1, std::memory_order_relaxed); });
+    printf("%-24s Execution time: %f seconds\n", "findSubsets/tasks", secondsSince(start));
+    printf("Subsets summing to %d: %lld\n", target, subsetsTasks);
+    ok = ok && subsets == subsetsTasks && reported == subsets;
+
+    // Nested: a parallel loop whose iterations fork sorts of their own
+    const std::size_t arrays = 8;
+    std::vector<std::vector<int>> batch(arrays, input);
+    start = std::chrono::steady_clock::now();
+    tasks.parallelFor(arrays, 1, [&](unsigned, std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; i++)
+            algo::parallelQuickSort(batch[i].data(), n, tasks);
+    });
+    printf("%-24s Execution time: %f seconds (%zu arrays)\n", "nested sorts/tasks", secondsSince(start), arrays);
+    for (const std::vector<int>& sorted : batch)
+        ok = ok && sorted == expected;
+
+    // Two pools: the loops of a one-worker pool, run from the tasks of a
+    // larger one, must see only their own pool's worker numbers
+    algo::TaskPool outer(tasks.size() + 1), inner(1);
+    std::atomic<bool> ownWorkers{true};
+    outer.parallelFor(64, 1, [&](unsigned, std::size_t, std::size_t) {
+        // Long enough for the other workers to steal iterations
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        inner.parallelFor(16, 1, [&](unsigned worker, std::size_t, std::size_t) {
+            if (worker >= inner.size())
+                ownWorkers.store(false, std::memory_order_relaxed);
+        });
+    });
+    printf("Nested pools: %s\n", ownWorkers ? "own workers" : "FOREIGN WORKER");
+    ok = ok && ownWorkers;
+
+    printf("Result: %s\n", ok ? "consistent" : "MISMATCH");
+    return ok ? 0 : 1;
+}
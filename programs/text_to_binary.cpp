@@ -0,0 +1,110 @@
+// Converts whitespace-separated text input into the binary container of
+// algorithms/binary_file.hpp, parsing on all cores:
+//
+//   text_to_binary array  in.txt out.bin [threads]  ints, e.g. a Linear Search array or SubsetSum set
+//   text_to_binary edges  in.txt out.bin [threads]  n m, then m lines u v w, as dijkstra_heap reads them
+//   text_to_binary matrix in.txt out.bin [threads]  n, then the n x n matrix with 0 for no edge, as
+//                                                   the original Dijkstra and Kruskal programs read it
+//
+// edges and matrix write a CSR graph; add "undirected" after the kind to
+// store every edge both ways. Numbers after the expected ones, such as
+// the start node of a Dijkstra input, are ignored.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "algorithms/binary_file.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static int usage()
+{
+    fprintf(stderr, "usage: text_to_binary array|edges|matrix [undirected] in.txt out.bin [threads]\n");
+    return 2;
+}
+
+int main(int argc, char** argv)
+{
+    int arg = 1;
+    if (argc < 4)
+        return usage();
+    const std::string kind = argv[arg++];
+    bool undirected = false;
+    if (!strcmp(argv[arg], "undirected")) {
+        undirected = true;
+        arg++;
+    }
+    if (argc - arg < 2 || (kind != "array" && kind != "edges" && kind != "matrix"))
+        return usage();
+    const char* input = argv[arg++];
+    const char* output = argv[arg++];
+    const unsigned threads = arg < argc ? static_cast<unsigned>(atoi(argv[arg])) : 0;
+
+    algo::MappedFile text;
+    if (!text.open(input, true)) {
+        perror(input);
+        return 1;
+    }
+    algo::ThreadPool pool(threads);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<int> numbers;
+    std::size_t errorAt = 0;
+    if (!algo::parseInts(text.data(), text.size(), numbers, &pool, &errorAt)) {
+        fprintf(stderr, "%s: not an int at byte %zu\n", input, errorAt);
+        return 1;
+    }
+    double elapsed = secondsSince(start);
+    printf("Parsed %zu ints from %zu bytes in %f seconds (%.0f MB/s, %u threads)\n", numbers.size(), text.size(),
+           elapsed, text.size() / 1e6 / elapsed, pool.size());
+
+    start = std::chrono::steady_clock::now();
+    bool ok;
+    if (kind == "array") {
+        ok = algo::writeBinaryArray(output, algo::Span<const int>(numbers));
+    } else {
+        const std::size_t header = kind == "edges" ? 2 : 1;
+        const long long n = numbers.empty() ? -1 : numbers[0];
+        const long long items = kind == "edges" ? (numbers.size() > 1 ? 3LL * numbers[1] : -1) : n * n;
+        if (n < 0 || items < 0 || numbers.size() - header < static_cast<std::size_t>(items)) {
+            fprintf(stderr, "%s: too few numbers for a %s graph\n", input, kind.c_str());
+            return 1;
+        }
+        if (numbers.size() - header > static_cast<std::size_t>(items))
+            printf("Ignoring %zu trailing numbers\n", numbers.size() - header - static_cast<std::size_t>(items));
+        const int* body = numbers.data() + header;
+        std::vector<algo::Edge> edges;
+        if (kind == "edges") {
+            edges.resize(static_cast<std::size_t>(numbers[1]));
+            for (std::size_t i = 0; i < edges.size(); i++) {
+                edges[i] = {body[3 * i], body[3 * i + 1], body[3 * i + 2]};
+                if (edges[i].u < 0 || edges[i].u >= n || edges[i].v < 0 || edges[i].v >= n) {
+                    fprintf(stderr, "%s: edge %zu has no vertex %d\n", input, i,
+                            edges[i].u < 0 || edges[i].u >= n ? edges[i].u : edges[i].v);
+                    return 1;
+                }
+            }
+        } else {
+            for (long long i = 0; i < n; i++)
+                for (long long j = 0; j < n; j++)
+                    if (body[i * n + j] != 0)
+                        edges.push_back({static_cast<int>(i), static_cast<int>(j), body[i * n + j]});
+        }
+        numbers = std::vector<int>();
+        algo::CsrGraph g = algo::buildCsr(static_cast<int>(n), edges, undirected);
+        ok = algo::writeBinaryGraph(output, g);
+        printf("Graph: %d vertices, %lld edges\n", g.n, static_cast<long long>(g.edgeCount()));
+    }
+    if (!ok) {
+        perror(output);
+        return 1;
+    }
+    printf("Wrote %s in %f seconds\n", output, secondsSince(start));
+    return 0;
+}